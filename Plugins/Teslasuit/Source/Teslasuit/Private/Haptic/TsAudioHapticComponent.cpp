@@ -0,0 +1,237 @@
+#include "Haptic/TsAudioHapticComponent.h"
+#include <atomic>
+#include "AudioDevice.h"
+#include "AudioThread.h"
+#include "ISubmixBufferListener.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Math/VectorRegister.h"
+#include "Haptic/TsHapticImpactComponent.h"
+#include "TsStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Audio Haptic Analysis"), STAT_TsAudioHapticAnalysis, STATGROUP_Teslasuit);
+
+/*!
+    \brief Band analysis of submix output, runs on the audio render thread.
+*/
+class FTsAudioHapticListener : public ISubmixBufferListener
+{
+public:
+    static constexpr int32 BandsCount = UTsAudioHapticComponent::BandsCount;
+
+    explicit FTsAudioHapticListener(const float (&Cutoffs_)[BandsCount])
+    {
+        for (int32 Band = 0; Band < BandsCount; ++Band)
+        {
+            Cutoffs[Band] = Cutoffs_[Band];
+            BandEnergy[Band].store(0.0f);
+        }
+    }
+
+    // ISubmixBufferListener interface
+    virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override;
+
+    /*!
+        \brief Takes energy accumulated since the previous call, returns number of frames it covers.
+    */
+    uint32 TakeEnergy(float (&OutEnergy)[BandsCount]);
+
+private:
+    void UpdateCoefficients(int32 SampleRate);
+
+private:
+    // Audio thread state
+    alignas(16) float FilterState[BandsCount] = {};
+    alignas(16) float FilterCoefficients[BandsCount] = {};
+    float Cutoffs[BandsCount] = {};
+    int32 CoefficientsSampleRate = 0;
+
+    // Shared state, written by audio thread and consumed by game thread
+    std::atomic<float> BandEnergy[BandsCount];
+    std::atomic<uint32> EnergyFrames{ 0 };
+};
+
+UTsAudioHapticComponent::UTsAudioHapticComponent()
+{
+    static_assert(UE_ARRAY_COUNT(Bands) == BandsCount, "Bands must match SIMD lanes.");
+
+    PrimaryComponentTick.bCanEverTick = true;
+
+    // Low frequencies are felt on torso and legs, high ones on arms
+    Bands[0].CutoffHz = 120.0f;
+    Bands[0].Bones = { FTsBoneIndex::TsBoneIndex_Hips, FTsBoneIndex::TsBoneIndex_Spine, FTsBoneIndex::TsBoneIndex_LeftUpperLeg, FTsBoneIndex::TsBoneIndex_RightUpperLeg };
+    Bands[1].CutoffHz = 500.0f;
+    Bands[1].Bones = { FTsBoneIndex::TsBoneIndex_Chest, FTsBoneIndex::TsBoneIndex_UpperSpine };
+    Bands[2].CutoffHz = 2000.0f;
+    Bands[2].Bones = { FTsBoneIndex::TsBoneIndex_LeftShoulder, FTsBoneIndex::TsBoneIndex_RightShoulder, FTsBoneIndex::TsBoneIndex_LeftUpperArm, FTsBoneIndex::TsBoneIndex_RightUpperArm };
+    Bands[3].CutoffHz = 6000.0f;
+    Bands[3].Bones = { FTsBoneIndex::TsBoneIndex_LeftLowerArm, FTsBoneIndex::TsBoneIndex_RightLowerArm };
+}
+
+void UTsAudioHapticComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (ImpactComponent == nullptr && GetOwner() != nullptr)
+    {
+        ImpactComponent = GetOwner()->FindComponentByClass<UTsHapticImpactComponent>();
+    }
+    if (ImpactComponent != nullptr)
+    {
+        // Impacts of the frame are added before impact component flushes them
+        ImpactComponent->AddTickPrerequisiteComponent(this);
+    }
+
+    auto World = GetWorld();
+    FAudioDeviceHandle AudioDevice = World != nullptr ? World->GetAudioDevice() : FAudioDeviceHandle();
+    if (!AudioDevice.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UTsAudioHapticComponent: no audio device, audio is not converted to haptic."));
+        return;
+    }
+
+    // Band setup is fixed while listening, audio thread reads its own copy
+    float Cutoffs[BandsCount];
+    for (int32 Band = 0; Band < BandsCount; ++Band)
+    {
+        Cutoffs[Band] = Bands[Band].CutoffHz;
+    }
+    Listener = MakeShared<FTsAudioHapticListener, ESPMode::ThreadSafe>(Cutoffs);
+    AudioDevice->RegisterSubmixBufferListener(Listener.Get(), Submix);
+    UE_LOG(LogTemp, Log, TEXT("UTsAudioHapticComponent: begin play."));
+}
+
+void UTsAudioHapticComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (Listener.IsValid())
+    {
+        auto World = GetWorld();
+        FAudioDeviceHandle AudioDevice = World != nullptr ? World->GetAudioDevice() : FAudioDeviceHandle();
+        if (AudioDevice.IsValid())
+        {
+            AudioDevice->UnregisterSubmixBufferListener(Listener.Get(), Submix);
+        }
+
+        // Unregistering is queued to the audio thread and buffers are delivered under the submix listeners lock,
+        // so the listener is released by a command queued after it, once no buffer can reach it
+        FAudioThread::RunCommandOnAudioThread([Retired = MoveTemp(Listener)]() mutable
+        {
+            Retired.Reset();
+        });
+    }
+    UE_LOG(LogTemp, Log, TEXT("UTsAudioHapticComponent: end play."));
+    Super::EndPlay(EndPlayReason);
+}
+
+void UTsAudioHapticComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // Levels are updated at control rate independent of frame rate
+    ControlTime += DeltaTime;
+    if (ControlTime >= 1.0f / ControlRate)
+    {
+        ControlTime = FMath::Fmod(ControlTime, 1.0f / ControlRate);
+        float Energy[BandsCount] = {};
+        const uint32 Frames = Listener.IsValid() ? Listener->TakeEnergy(Energy) : 0;
+        for (int32 Band = 0; Band < BandsCount; ++Band)
+        {
+            Levels[Band] = Frames > 0 ? FMath::Sqrt(Energy[Band] / Frames) : 0.0f;
+        }
+    }
+
+    // Impact component reduces contacts of a single frame, held levels are submitted every frame
+    if (ImpactComponent == nullptr)
+    {
+        return;
+    }
+    for (int32 Band = 0; Band < BandsCount; ++Band)
+    {
+        const auto& Setup = Bands[Band];
+        if (Levels[Band] < Setup.Threshold)
+        {
+            continue;
+        }
+        const float Intensity = FMath::Min((Levels[Band] - Setup.Threshold) * Setup.Gain, 1.0f);
+        for (auto Bone : Setup.Bones)
+        {
+            ImpactComponent->AddImpact(Bone, Intensity);
+        }
+    }
+}
+
+float UTsAudioHapticComponent::GetBandLevel(int32 Band) const
+{
+    return Band >= 0 && Band < BandsCount ? Levels[Band] : 0.0f;
+}
+
+void FTsAudioHapticListener::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock)
+{
+    SCOPE_CYCLE_COUNTER(STAT_TsAudioHapticAnalysis);
+    if (NumChannels <= 0 || SampleRate <= 0)
+    {
+        return;
+    }
+    if (SampleRate != CoefficientsSampleRate)
+    {
+        UpdateCoefficients(SampleRate);
+    }
+
+    // Four low-pass filters run in SIMD lanes, bands are differences of neighbouring lanes
+    const VectorRegister4Float Coefficients = VectorLoadAligned(FilterCoefficients);
+    const VectorRegister4Float LaneMask = MakeVectorRegisterFloat(0.0f, 1.0f, 1.0f, 1.0f);
+    VectorRegister4Float State = VectorLoadAligned(FilterState);
+    VectorRegister4Float Energy = VectorZeroFloat();
+
+    const float ChannelScale = 1.0f / NumChannels;
+    const int32 NumFrames = NumSamples / NumChannels;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        const float* Samples = AudioData + Frame * NumChannels;
+        float Mono = 0.0f;
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            Mono += Samples[Channel];
+        }
+        const VectorRegister4Float Input = VectorSetFloat1(Mono * ChannelScale);
+        State = VectorMultiplyAdd(Coefficients, VectorSubtract(Input, State), State);
+
+        const VectorRegister4Float Lower = VectorMultiply(VectorSwizzle(State, 0, 0, 1, 2), LaneMask);
+        const VectorRegister4Float Band = VectorSubtract(State, Lower);
+        Energy = VectorMultiplyAdd(Band, Band, Energy);
+    }
+    VectorStoreAligned(State, FilterState);
+
+    // Publish energy without locks, game thread takes it at control rate
+    alignas(16) float BufferEnergy[BandsCount];
+    VectorStoreAligned(Energy, BufferEnergy);
+    for (int32 Band = 0; Band < BandsCount; ++Band)
+    {
+        float Current = BandEnergy[Band].load(std::memory_order_relaxed);
+        while (!BandEnergy[Band].compare_exchange_weak(Current, Current + BufferEnergy[Band], std::memory_order_relaxed))
+        {
+        }
+    }
+    EnergyFrames.fetch_add(static_cast<uint32>(NumFrames), std::memory_order_release);
+}
+
+uint32 FTsAudioHapticListener::TakeEnergy(float (&OutEnergy)[BandsCount])
+{
+    const uint32 Frames = EnergyFrames.exchange(0);
+    for (int32 Band = 0; Band < BandsCount; ++Band)
+    {
+        OutEnergy[Band] = BandEnergy[Band].exchange(0.0f);
+    }
+    return Frames;
+}
+
+void FTsAudioHapticListener::UpdateCoefficients(int32 SampleRate)
+{
+    for (int32 Band = 0; Band < BandsCount; ++Band)
+    {
+        const float Cutoff = FMath::Min(Cutoffs[Band], SampleRate * 0.45f);
+        FilterCoefficients[Band] = 1.0f - FMath::Exp(-2.0f * PI * Cutoff / SampleRate);
+        FilterState[Band] = 0.0f;
+    }
+    CoefficientsSampleRate = SampleRate;
+}
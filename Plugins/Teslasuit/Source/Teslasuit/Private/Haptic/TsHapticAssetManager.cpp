@@ -1,7 +1,14 @@
 #include "Haptic/TsHapticAssetManager.h"
+#include "Async/ParallelFor.h"
 #include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticPlayablePool.h"
+#include "TsDeviceProvider.h"
+#include "TsStats.h"
 #include "ts_api/ts_asset_api.h"
 #include "ts_api/ts_haptic_api.h"
+#include <algorithm>
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Haptic Broadcast Skew (ms)"), STAT_TsHapticBroadcastSkew, STATGROUP_Teslasuit);
 
 TsHapticAssetManager::TsHapticAssetManager()
 {
@@ -18,11 +25,14 @@ TsHapticAssetManager::~TsHapticAssetManager()
 
 void* TsHapticAssetManager::LoadAsset(const UTsAsset& Asset)
 {
-    // Check if asset already loaded
-    auto It = AssetHandles.find(Asset.GetUniqueID());
+    // Check if asset or its duplicate already loaded
+    const auto Key = GetAssetKey(Asset);
+    auto It = AssetHandles.find(Key);
     if (It != AssetHandles.end())
     {
-        return It->second;
+        It->second.Users.insert(Asset.GetUniqueID());
+        Asset.ReleasePayload();
+        return It->second.Handle;
     }
 
     // Load asset and get handle
@@ -32,7 +42,9 @@ void* TsHapticAssetManager::LoadAsset(const UTsAsset& Asset)
         UE_LOG(LogTemp, Error, TEXT("TsHapticAssetManager: failed to load asset - null ts_asset_load_from_binary_data handle."));
         return nullptr;
     }
-    auto Handle = static_cast<void*>(LoadFn(Asset.GetData().GetData(), Asset.GetData().Num()));
+    // Payload is moved out of the asset and lives with the loaded handle
+    auto Payload = Asset.AcquirePayload();
+    auto Handle = static_cast<void*>(LoadFn(Payload.GetData(), Payload.Num()));
     if (Handle == nullptr)
     {
         UE_LOG(LogTemp, Error, TEXT("TsHapticAssetManager: failed to load asset - null handle returned."));
@@ -40,10 +52,67 @@ void* TsHapticAssetManager::LoadAsset(const UTsAsset& Asset)
     }
 
     // Store and return handle
-    AssetHandles[Asset.GetUniqueID()] = Handle;
+    auto& Loaded = AssetHandles[Key];
+    Loaded.Handle = Handle;
+    Loaded.Payload = MoveTemp(Payload);
+    Loaded.Users.insert(Asset.GetUniqueID());
     return Handle;
 }
 
+ETsAssetType TsHapticAssetManager::InspectAsset(const uint8* Data, std::size_t Size, float* OutDuration)
+{
+    auto LoadFn = reinterpret_cast<decltype(&ts_asset_load_from_binary_data)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_asset_load_from_binary_data")));
+    auto GetTypeFn = reinterpret_cast<decltype(&ts_asset_get_type)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_asset_get_type")));
+    if (LoadFn == nullptr || GetTypeFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticAssetManager: failed to inspect asset - null asset API handle."));
+        return ETsAssetType::Undefined;
+    }
+    if (Data == nullptr || Size == 0)
+    {
+        return ETsAssetType::Undefined;
+    }
+    auto Handle = LoadFn(Data, Size);
+    if (Handle == nullptr)
+    {
+        return ETsAssetType::Undefined;
+    }
+    TsAssetType Type = 0;
+    const auto StatusCode = GetTypeFn(Handle, &Type);
+    if (OutDuration != nullptr)
+    {
+        *OutDuration = StatusCode == 0 ? MeasureDuration(static_cast<void*>(Handle)) : 0.0f;
+    }
+    UnloadAsset(static_cast<void*>(Handle));
+    if (StatusCode != 0 || Type > static_cast<TsAssetType>(ETsAssetType::SceneAnimation))
+    {
+        return ETsAssetType::Undefined;
+    }
+    return static_cast<ETsAssetType>(Type);
+}
+
+float TsHapticAssetManager::MeasureDuration(void* AssetHandle)
+{
+    // Any connected device reports duration of the asset, without device it stays unknown
+    auto& Provider = ITeslasuitPlugin::Get().GetDeviceProvider();
+    const auto& Ids = Provider.GetDeviceIds();
+    auto DeviceHandle = Ids.empty() ? nullptr : Provider.GetDeviceHandle(*Ids.begin());
+    auto GetDurationFn = reinterpret_cast<decltype(&ts_haptic_get_playable_duration)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_duration")));
+    if (DeviceHandle == nullptr || GetDurationFn == nullptr)
+    {
+        return 0.0f;
+    }
+    const auto PlayableId = CreatePlayable(DeviceHandle, AssetHandle);
+    if (PlayableId == 0)
+    {
+        return 0.0f;
+    }
+    std::uint64_t DurationMs = 0;
+    const auto StatusCode = GetDurationFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId, &DurationMs);
+    RemovePlayable(DeviceHandle, PlayableId);
+    return StatusCode == 0 ? DurationMs / 1000.0f : 0.0f;
+}
+
 std::uint64_t TsHapticAssetManager::CreatePlayable(void* DeviceHandle, void* AssetHandle)
 {
     // Create haptic playable from asset
@@ -77,6 +146,86 @@ void TsHapticAssetManager::RemovePlayable(void* DeviceHandle, std::uint64_t Play
     RemoveFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId);
 }
 
+TsHapticAssetManager::BroadcastResult TsHapticAssetManager::PlayOnDevices(const std::vector<void*>& DeviceHandles, const UTsAsset& Asset, const FTsHapticVoiceParams& Params)
+{
+    BroadcastResult Result;
+    auto PlayFn = reinterpret_cast<decltype(&ts_haptic_play_playable)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
+    if (PlayFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticAssetManager: failed to broadcast asset - null ts_haptic_play_playable handle."));
+        return Result;
+    }
+    // Broadcasts hold a single load of the asset no matter how many times it is played
+    void* AssetHandle = nullptr;
+    auto Loaded = AssetHandles.find(GetAssetKey(Asset));
+    if (BroadcastAssets.count(Asset.GetUniqueID()) != 0 && Loaded != AssetHandles.end())
+    {
+        AssetHandle = Loaded->second.Handle;
+    }
+    else
+    {
+        AssetHandle = LoadAsset(Asset);
+        if (AssetHandle == nullptr)
+        {
+            return Result;
+        }
+        BroadcastAssets.insert(Asset.GetUniqueID());
+    }
+
+    // Acquire playables only for devices which haven't played the asset yet, busy devices virtualize the broadcast
+    auto& VM = ITeslasuitPlugin::Get().GetHapticVoiceManager();
+    auto& Pool = ITeslasuitPlugin::Get().GetHapticPlayablePool();
+    std::vector<std::pair<TsDeviceHandle*, std::uint64_t>> Targets;
+    Targets.reserve(DeviceHandles.size());
+    for (auto DeviceHandle : DeviceHandles)
+    {
+        const auto Key = std::make_pair(DeviceHandle, Asset.GetUniqueID());
+        auto It = BroadcastPlayables.find(Key);
+        if (It == BroadcastPlayables.end())
+        {
+            const auto PlayableId = Pool.Acquire(DeviceHandle, AssetHandle);
+            if (PlayableId == 0)
+            {
+                continue;
+            }
+            It = BroadcastPlayables.emplace(Key, PlayableId).first;
+        }
+        if (!VM.Admit(DeviceHandle, It->second, Params, Asset.GetDuration()))
+        {
+            continue;
+        }
+        Targets.emplace_back(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), It->second);
+    }
+    if (Targets.empty())
+    {
+        return Result;
+    }
+
+    // Fan out play commands and record when each command is handed to the device
+    std::vector<double> StartTimes(Targets.size());
+    ParallelFor(static_cast<int32>(Targets.size()), [&Targets, &StartTimes, PlayFn](int32 Index)
+    {
+        PlayFn(Targets[Index].first, Targets[Index].second);
+        StartTimes[Index] = FPlatformTime::Seconds();
+    });
+
+    const auto Range = std::minmax_element(StartTimes.begin(), StartTimes.end());
+    Result.Played = static_cast<int32>(Targets.size());
+    Result.SkewMs = (*Range.second - *Range.first) * 1000.0;
+    SET_FLOAT_STAT(STAT_TsHapticBroadcastSkew, Result.SkewMs);
+    return Result;
+}
+
+void TsHapticAssetManager::RemoveDevice(void* DeviceHandle)
+{
+    // Device handle is no longer valid, drop its playables without API calls
+    UsedDevices.erase(DeviceHandle);
+    for (auto It = BroadcastPlayables.begin(); It != BroadcastPlayables.end();)
+    {
+        It = It->first.first == DeviceHandle ? BroadcastPlayables.erase(It) : std::next(It);
+    }
+}
+
 void TsHapticAssetManager::RemoveAllPlayables()
 {
     // Find clear function
@@ -93,16 +242,48 @@ void TsHapticAssetManager::RemoveAllPlayables()
         ClearFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle));
     }
     UsedDevices.clear();
+    BroadcastPlayables.clear();
 }
 
 void TsHapticAssetManager::UnloadAsset(const UTsAsset& Asset)
 {
-    // Unload asset if it is loaded
-    auto It = AssetHandles.find(Asset.GetUniqueID());
+    // Return cached broadcast playables of the asset to the pool
+    auto& Pool = ITeslasuitPlugin::Get().GetHapticPlayablePool();
+    for (auto PlayableIt = BroadcastPlayables.begin(); PlayableIt != BroadcastPlayables.end();)
+    {
+        if (PlayableIt->first.second == Asset.GetUniqueID())
+        {
+            Pool.Release(PlayableIt->first.first, PlayableIt->second);
+            PlayableIt = BroadcastPlayables.erase(PlayableIt);
+        }
+        else
+        {
+            ++PlayableIt;
+        }
+    }
+
+    // Release the caller load and the broadcast one, unload asset if it is not used by anyone else
+    auto It = AssetHandles.find(GetAssetKey(Asset));
     if (It != AssetHandles.end())
     {
-        UnloadAsset(It->second);
-        AssetHandles.erase(It);
+        const auto Releases = BroadcastAssets.erase(Asset.GetUniqueID()) + 1;
+        for (std::size_t Index = 0; Index < Releases; ++Index)
+        {
+            auto User = It->second.Users.find(Asset.GetUniqueID());
+            if (User != It->second.Users.end())
+            {
+                It->second.Users.erase(User);
+            }
+        }
+        if (It->second.Users.empty())
+        {
+            for (auto& Callback : UnloadCallbacks)
+            {
+                Callback.second(It->second.Handle);
+            }
+            UnloadAsset(It->second.Handle);
+            AssetHandles.erase(It);
+        }
     }
 }
 
@@ -130,12 +311,38 @@ void TsHapticAssetManager::UnloadAllAssets()
     // Unload all registered assets
     for (auto& It : AssetHandles)
     {
-        UnloadAsset(It.second);
+        for (auto& Callback : UnloadCallbacks)
+        {
+            Callback.second(It.second.Handle);
+        }
+        UnloadAsset(It.second.Handle);
     }
     AssetHandles.clear();
+    BroadcastAssets.clear();
+}
+
+void TsHapticAssetManager::SubscribeOnUnload(intptr_t SubscriberId, const UnloadCallback& Cb)
+{
+    UnloadCallbacks[SubscriberId] = Cb;
+}
+
+void TsHapticAssetManager::UnSubscribeOnUnload(intptr_t SubscriberId)
+{
+    UnloadCallbacks.erase(SubscriberId);
 }
 
 void TsHapticAssetManager::SetLibHandle(void* Handle)
 {
     LibHandle = Handle;
 }
+
+std::string TsHapticAssetManager::GetAssetKey(const UTsAsset& Asset)
+{
+    // Assets saved without content hash are not shared
+    const auto Hash = Asset.GetContentHash();
+    if (Hash.IsEmpty())
+    {
+        return "id:" + std::to_string(Asset.GetUniqueID());
+    }
+    return TCHAR_TO_UTF8(*Hash);
+}
@@ -0,0 +1,212 @@
+#include "Haptic/TsHapticImpactComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+#include "Haptic/TsHapticThread.h"
+#include "ts_api/ts_haptic_api.h"
+
+UTsHapticImpactComponent::UTsHapticImpactComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    Pending.fill(0.0f);
+    Levels.fill(0.0f);
+    Flushed.fill(0.0f);
+}
+
+void UTsHapticImpactComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
+
+    // Gather contacts of all owner's bodies
+    if (bListenOwnerHits && GetOwner() != nullptr)
+    {
+        TArray<UPrimitiveComponent*> Primitives;
+        GetOwner()->GetComponents<UPrimitiveComponent>(Primitives);
+        for (auto Primitive : Primitives)
+        {
+            Primitive->OnComponentHit.AddDynamic(this, &UTsHapticImpactComponent::OnOwnerHit);
+        }
+    }
+    UE_LOG(LogTemp, Log, TEXT("UTsHapticImpactComponent: begin play."));
+}
+
+void UTsHapticImpactComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopMaterial();
+    UE_LOG(LogTemp, Log, TEXT("UTsHapticImpactComponent: end play."));
+    Super::EndPlay(EndPlayReason);
+}
+
+void UTsHapticImpactComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+    Flush(DeltaTime);
+}
+
+void UTsHapticImpactComponent::SetTsDevice(UTsDevice* Device_)
+{
+    StopMaterial();
+    Device = Device_;
+    if (Device == nullptr || Device->Handle == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsHapticImpactComponent: failed to set device - null device."));
+        return;
+    }
+    Mapping.Build(LibHandle, Device->Handle);
+    StartMaterial();
+}
+
+void UTsHapticImpactComponent::AddImpact(FTsBoneIndex Bone, float Intensity)
+{
+    const auto Index = static_cast<std::size_t>(Bone);
+    if (Index >= BonesCount || Intensity <= 0.0f)
+    {
+        return;
+    }
+    Intensity = FMath::Min(Intensity, 1.0f);
+
+    auto& Value = Pending[Index];
+    Value = Reduction == ETsImpactReduction::Sum ? FMath::Min(Value + Intensity, 1.0f) : FMath::Max(Value, Intensity);
+    PendingMask |= 1ull << Index;
+}
+
+void UTsHapticImpactComponent::OnOwnerHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+    const auto Bone = BodyToBone.Find(Hit.MyBoneName);
+    AddImpact(Bone != nullptr ? *Bone : DefaultBone, NormalImpulse.Size() * ImpulseScale);
+}
+
+void UTsHapticImpactComponent::StartMaterial()
+{
+    if (MaterialAsset == nullptr || !Mapping.IsValid())
+    {
+        return;
+    }
+
+    auto SetLoopedFn = reinterpret_cast<decltype(&ts_haptic_set_playable_looped)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_set_playable_looped")));
+    auto PlayFn = reinterpret_cast<decltype(&ts_haptic_play_playable)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
+    if (SetLoopedFn == nullptr || PlayFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsHapticImpactComponent: failed to start material - null haptic API handle."));
+        return;
+    }
+
+    // Material playable keeps playing, contacts only change its channel impacts
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    auto AssetHandle = AM.LoadAsset(*MaterialAsset);
+    if (AssetHandle == nullptr)
+    {
+        return;
+    }
+    PlayableId = AM.CreatePlayable(Device->Handle, AssetHandle);
+    if (PlayableId == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsHapticImpactComponent: failed to start material - playable not created."));
+        AM.UnloadAsset(*MaterialAsset);
+        return;
+    }
+    LoadedMaterial = MaterialAsset;
+
+    auto Handle = reinterpret_cast<TsDeviceHandle*>(Device->Handle);
+    SetLoopedFn(Handle, PlayableId, true);
+    PlayFn(Handle, PlayableId);
+}
+
+void UTsHapticImpactComponent::StopMaterial()
+{
+    if (Device == nullptr || Device->Handle == nullptr || PlayableId == 0)
+    {
+        return;
+    }
+
+    // Impacts queued for the playable must reach it before it's removed
+    ITeslasuitPlugin::Get().GetHapticThread().Flush();
+    auto StopFn = reinterpret_cast<decltype(&ts_haptic_stop_playable)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_stop_playable")));
+    if (StopFn != nullptr)
+    {
+        StopFn(reinterpret_cast<TsDeviceHandle*>(Device->Handle), PlayableId);
+    }
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    AM.RemovePlayable(Device->Handle, PlayableId);
+    if (LoadedMaterial != nullptr)
+    {
+        AM.UnloadAsset(*LoadedMaterial);
+        LoadedMaterial = nullptr;
+    }
+    PlayableId = 0;
+
+    Pending.fill(0.0f);
+    Levels.fill(0.0f);
+    Flushed.fill(0.0f);
+    PendingMask = 0;
+    ActiveMask = 0;
+}
+
+void UTsHapticImpactComponent::Flush(float DeltaTime)
+{
+    const float DecayFactor = FMath::Exp(-DecayRate * DeltaTime);
+
+    // Visit only bones touched this frame or still sounding
+    std::uint64_t Bits = PendingMask | ActiveMask;
+    std::uint64_t NextActive = 0;
+    Commands.clear();
+    while (Bits != 0)
+    {
+        const auto Index = static_cast<std::size_t>(FMath::CountTrailingZeros64(Bits));
+        Bits &= Bits - 1;
+
+        // Reduce bone contacts into impact level
+        float Level = Pending[Index];
+        if (Reduction == ETsImpactReduction::Decay)
+        {
+            Level = FMath::Max(Level, Levels[Index] * DecayFactor);
+            if (Level < KINDA_SMALL_NUMBER)
+            {
+                Level = 0.0f;
+            }
+        }
+        Pending[Index] = 0.0f;
+        Levels[Index] = Level;
+
+        // Skip changes which can't be felt
+        const bool bChanged = FMath::Abs(Level - Flushed[Index]) >= ChangeThreshold || (Level == 0.0f && Flushed[Index] > 0.0f);
+        if (bChanged)
+        {
+            Flushed[Index] = Level;
+            for (auto Channel : Mapping.GetChannels(static_cast<FTsBoneIndex>(Index)))
+            {
+                Commands.emplace_back(Channel, Level);
+            }
+        }
+        if (Level > 0.0f || Flushed[Index] > 0.0f)
+        {
+            NextActive |= 1ull << Index;
+        }
+    }
+    PendingMask = 0;
+    ActiveMask = NextActive;
+
+    if (Commands.empty() || PlayableId == 0 || Device == nullptr || Device->Handle == nullptr)
+    {
+        return;
+    }
+
+    // Send changed channels in one batch from haptic thread
+    auto SetImpactFn = reinterpret_cast<decltype(&ts_haptic_set_material_channel_impact)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_set_material_channel_impact")));
+    if (SetImpactFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsHapticImpactComponent: failed to set impacts - null ts_haptic_set_material_channel_impact handle."));
+        return;
+    }
+    ITeslasuitPlugin::Get().GetHapticThread().Enqueue(
+        [SetImpactFn, Handle = reinterpret_cast<TsDeviceHandle*>(Device->Handle), Id = PlayableId, Batch = Commands]()
+    {
+        for (const auto& Command : Batch)
+        {
+            SetImpactFn(Handle, static_cast<TsMapping2dBoneContent>(Command.first), Command.second, Id);
+        }
+    });
+}
@@ -0,0 +1,106 @@
+#include "Haptic/TsHapticMapping.h"
+#include "ts_api/ts_mapping_api.h"
+
+namespace
+{
+    const TsLayout2dType ElectricLayoutType = 1;
+    const TsLayout2dElementType ChannelElementType = 2;
+}
+
+bool TsHapticMapping::Build(void* LibHandle, void* DeviceHandle)
+{
+    Reset();
+
+    auto GetByDeviceFn = reinterpret_cast<decltype(&ts_mapping2d_get_by_device)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_get_by_device")));
+    auto GetNumberOfLayoutsFn = reinterpret_cast<decltype(&ts_mapping2d_get_number_of_layouts)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_get_number_of_layouts")));
+    auto GetLayoutsFn = reinterpret_cast<decltype(&ts_mapping2d_get_layouts)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_get_layouts")));
+    auto GetLayoutTypeFn = reinterpret_cast<decltype(&ts_mapping2d_layout_get_type)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_layout_get_type")));
+    auto GetElementTypeFn = reinterpret_cast<decltype(&ts_mapping2d_layout_get_element_type)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_layout_get_element_type")));
+    auto GetNumberOfBonesFn = reinterpret_cast<decltype(&ts_mapping2d_layout_get_number_of_bones)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_layout_get_number_of_bones")));
+    auto GetBonesFn = reinterpret_cast<decltype(&ts_mapping2d_layout_get_bones)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_layout_get_bones")));
+    auto GetBoneIndexFn = reinterpret_cast<decltype(&ts_mapping2d_bone_get_index)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_bone_get_index")));
+    auto GetNumberOfContentsFn = reinterpret_cast<decltype(&ts_mapping2d_bone_get_number_of_contents)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_bone_get_number_of_contents")));
+    auto GetContentsFn = reinterpret_cast<decltype(&ts_mapping2d_bone_get_contents)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mapping2d_bone_get_contents")));
+    if (!GetByDeviceFn || !GetNumberOfLayoutsFn || !GetLayoutsFn || !GetLayoutTypeFn || !GetElementTypeFn ||
+        !GetNumberOfBonesFn || !GetBonesFn || !GetBoneIndexFn || !GetNumberOfContentsFn || !GetContentsFn)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticMapping: failed to build mapping - null mapping API handle."));
+        return false;
+    }
+
+    // Get device mapping and its layouts
+    TsMapping2d Mapping = nullptr;
+    auto StatusCode = GetByDeviceFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), &Mapping);
+    if (StatusCode != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticMapping: failed to get device mapping - code: %i."), StatusCode);
+        return false;
+    }
+    uint64_t LayoutsCount = 0;
+    GetNumberOfLayoutsFn(Mapping, &LayoutsCount);
+    std::vector<TsLayout2d> Layouts(LayoutsCount);
+    GetLayoutsFn(Mapping, Layouts.data(), LayoutsCount);
+
+    // Collect channels of electric layout by bones
+    for (auto Layout : Layouts)
+    {
+        TsLayout2dType LayoutType = 0;
+        TsLayout2dElementType ElementType = 0;
+        GetLayoutTypeFn(Layout, &LayoutType);
+        GetElementTypeFn(Layout, &ElementType);
+        if (LayoutType != ElectricLayoutType || ElementType != ChannelElementType)
+        {
+            continue;
+        }
+
+        uint64_t BonesNumber = 0;
+        GetNumberOfBonesFn(Layout, &BonesNumber);
+        std::vector<TsMapping2dBone> Bones(BonesNumber);
+        GetBonesFn(Layout, Bones.data(), BonesNumber);
+        for (auto Bone : Bones)
+        {
+            TsBoneIndex BoneIndex;
+            GetBoneIndexFn(Bone, &BoneIndex);
+            if (static_cast<std::size_t>(BoneIndex) >= BonesCount)
+            {
+                continue;
+            }
+
+            uint64_t ContentsNumber = 0;
+            GetNumberOfContentsFn(Bone, &ContentsNumber);
+            std::vector<TsMapping2dBoneContent> Contents(ContentsNumber);
+            GetContentsFn(Bone, Contents.data(), ContentsNumber);
+            auto& Target = BoneChannels[static_cast<std::size_t>(BoneIndex)];
+            Target.insert(Target.end(), Contents.begin(), Contents.end());
+        }
+        bValid = true;
+        break;
+    }
+
+    if (!bValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TsHapticMapping: device mapping has no electric channels layout."));
+    }
+    return bValid;
+}
+
+const TsHapticMapping::Channels& TsHapticMapping::GetChannels(FTsBoneIndex Bone) const
+{
+    static const Channels Empty;
+    const auto Index = static_cast<std::size_t>(Bone);
+    return Index < BonesCount ? BoneChannels[Index] : Empty;
+}
+
+bool TsHapticMapping::IsValid() const
+{
+    return bValid;
+}
+
+void TsHapticMapping::Reset()
+{
+    for (auto& Channels : BoneChannels)
+    {
+        Channels.clear();
+    }
+    bValid = false;
+}
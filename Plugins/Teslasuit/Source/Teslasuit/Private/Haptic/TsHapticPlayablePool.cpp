@@ -0,0 +1,301 @@
+#include "Haptic/TsHapticPlayablePool.h"
+#include <algorithm>
+#include "ts_api/ts_haptic_api.h"
+
+struct TsHapticPlayablePool::ApiFunctions
+{
+    decltype(&ts_haptic_create_playable_from_asset) CreateFn = nullptr;
+    decltype(&ts_haptic_remove_playable) RemoveFn = nullptr;
+    decltype(&ts_haptic_play_playable) PlayFn = nullptr;
+    decltype(&ts_haptic_stop_playable) StopFn = nullptr;
+    decltype(&ts_haptic_is_playable_playing) IsPlayingFn = nullptr;
+    decltype(&ts_haptic_add_channel_to_dynamic_playable) AddChannelFn = nullptr;
+    decltype(&ts_haptic_remove_channel_from_dynamic_playable) RemoveChannelFn = nullptr;
+
+    bool IsValid() const
+    {
+        return CreateFn && RemoveFn && PlayFn && StopFn && IsPlayingFn && AddChannelFn && RemoveChannelFn;
+    }
+};
+
+TsHapticPlayablePool::TsHapticPlayablePool()
+    : Api(std::make_unique<ApiFunctions>())
+{
+    UE_LOG(LogTemp, Log, TEXT("TsHapticPlayablePool: constructed."));
+}
+
+TsHapticPlayablePool::~TsHapticPlayablePool()
+{
+    // Remove forgotten playables
+    Clear();
+    UE_LOG(LogTemp, Log, TEXT("TsHapticPlayablePool: deconstructed."));
+}
+
+void TsHapticPlayablePool::Reserve(void* DeviceHandle, void* AssetHandle, std::size_t Count)
+{
+    auto& Pool = Pools[DeviceHandle];
+    auto& FreeIds = Pool.FreeIds[AssetHandle];
+    while (FreeIds.size() < Count)
+    {
+        const auto PlayableId = CreatePlayable(DeviceHandle, AssetHandle);
+        if (PlayableId == 0)
+        {
+            return;
+        }
+        auto& Item = Pool.Playables[PlayableId];
+        Item.AssetHandle = AssetHandle;
+        FreeIds.push_back(PlayableId);
+    }
+}
+
+std::uint64_t TsHapticPlayablePool::Acquire(void* DeviceHandle, void* AssetHandle)
+{
+    auto& Pool = Pools[DeviceHandle];
+
+    // Recycle finished playables only when there is nothing to reuse
+    auto* FreeIds = &Pool.FreeIds[AssetHandle];
+    if (FreeIds->empty())
+    {
+        Recycle(DeviceHandle, Pool);
+        FreeIds = &Pool.FreeIds[AssetHandle];
+    }
+
+    // Reuse free playable
+    if (!FreeIds->empty())
+    {
+        const auto PlayableId = FreeIds->back();
+        FreeIds->pop_back();
+        Pool.Playables[PlayableId].bInUse = true;
+        ++Counters.Reused;
+        return PlayableId;
+    }
+
+    // Grow pool on demand
+    const auto PlayableId = CreatePlayable(DeviceHandle, AssetHandle);
+    if (PlayableId == 0)
+    {
+        return 0;
+    }
+    auto& Item = Pool.Playables[PlayableId];
+    Item.AssetHandle = AssetHandle;
+    Item.bInUse = true;
+    return PlayableId;
+}
+
+void TsHapticPlayablePool::SetChannels(void* DeviceHandle, std::uint64_t PlayableId, const std::vector<void*>& Channels)
+{
+    auto Item = FindPlayable(DeviceHandle, PlayableId);
+    if (Item == nullptr || !Api->IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to set channels - unknown playable %llu."), PlayableId);
+        return;
+    }
+
+    auto Device = reinterpret_cast<TsDeviceHandle*>(DeviceHandle);
+
+    // Detach channels which are not requested anymore
+    for (auto It = Item->Channels.begin(); It != Item->Channels.end();)
+    {
+        if (std::find(Channels.begin(), Channels.end(), *It) == Channels.end())
+        {
+            Api->RemoveChannelFn(Device, static_cast<TsMapping2dBoneContent>(*It), PlayableId);
+            ++Counters.ChannelsRemoved;
+            It = Item->Channels.erase(It);
+        }
+        else
+        {
+            ++It;
+        }
+    }
+
+    // Attach new channels
+    for (auto Channel : Channels)
+    {
+        if (std::find(Item->Channels.begin(), Item->Channels.end(), Channel) == Item->Channels.end())
+        {
+            const auto StatusCode = Api->AddChannelFn(Device, static_cast<TsMapping2dBoneContent>(Channel), PlayableId);
+            if (StatusCode != 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to add channel - code: %i."), StatusCode);
+                continue;
+            }
+            ++Counters.ChannelsAdded;
+            Item->Channels.push_back(Channel);
+        }
+    }
+}
+
+void TsHapticPlayablePool::Play(void* DeviceHandle, std::uint64_t PlayableId, bool bReleaseOnFinish)
+{
+    auto Item = FindPlayable(DeviceHandle, PlayableId);
+    if (Item == nullptr || !Api->IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to play - unknown playable %llu."), PlayableId);
+        return;
+    }
+    Item->bReleaseOnFinish = bReleaseOnFinish;
+    Api->PlayFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId);
+}
+
+void TsHapticPlayablePool::Release(void* DeviceHandle, std::uint64_t PlayableId)
+{
+    auto PoolIt = Pools.find(DeviceHandle);
+    if (PoolIt == Pools.end())
+    {
+        return;
+    }
+    auto It = PoolIt->second.Playables.find(PlayableId);
+    if (It == PoolIt->second.Playables.end() || !It->second.bInUse)
+    {
+        return;
+    }
+    if (Api->StopFn)
+    {
+        Api->StopFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId);
+    }
+    ReturnToPool(PoolIt->second, PlayableId, It->second);
+}
+
+void TsHapticPlayablePool::Update()
+{
+    for (auto& It : Pools)
+    {
+        Recycle(It.first, It.second);
+    }
+}
+
+void TsHapticPlayablePool::RemoveAsset(void* AssetHandle)
+{
+    for (auto& PoolIt : Pools)
+    {
+        auto& Pool = PoolIt.second;
+        for (auto It = Pool.Playables.begin(); It != Pool.Playables.end();)
+        {
+            if (It->second.AssetHandle != AssetHandle)
+            {
+                ++It;
+                continue;
+            }
+            if (Api->RemoveFn)
+            {
+                Api->RemoveFn(reinterpret_cast<TsDeviceHandle*>(PoolIt.first), It->first);
+            }
+            It = Pool.Playables.erase(It);
+        }
+        Pool.FreeIds.erase(AssetHandle);
+    }
+}
+
+void TsHapticPlayablePool::RemoveDevice(void* DeviceHandle)
+{
+    // Device handle is no longer valid, drop its playables without API calls
+    Pools.erase(DeviceHandle);
+}
+
+void TsHapticPlayablePool::Clear()
+{
+    // Remove all playables of connected devices
+    if (Api->RemoveFn)
+    {
+        for (auto& PoolIt : Pools)
+        {
+            for (auto& It : PoolIt.second.Playables)
+            {
+                Api->RemoveFn(reinterpret_cast<TsDeviceHandle*>(PoolIt.first), It.first);
+            }
+        }
+    }
+    Pools.clear();
+}
+
+const TsHapticPlayablePool::Stats& TsHapticPlayablePool::GetStats() const
+{
+    return Counters;
+}
+
+void TsHapticPlayablePool::SetLibHandle(void* Handle)
+{
+    LibHandle = Handle;
+
+    // Resolve functions once, pool is used on hot paths
+    Api->CreateFn = reinterpret_cast<decltype(&ts_haptic_create_playable_from_asset)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_create_playable_from_asset")));
+    Api->RemoveFn = reinterpret_cast<decltype(&ts_haptic_remove_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_remove_playable")));
+    Api->PlayFn = reinterpret_cast<decltype(&ts_haptic_play_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
+    Api->StopFn = reinterpret_cast<decltype(&ts_haptic_stop_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_stop_playable")));
+    Api->IsPlayingFn = reinterpret_cast<decltype(&ts_haptic_is_playable_playing)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_is_playable_playing")));
+    Api->AddChannelFn = reinterpret_cast<decltype(&ts_haptic_add_channel_to_dynamic_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_add_channel_to_dynamic_playable")));
+    Api->RemoveChannelFn = reinterpret_cast<decltype(&ts_haptic_remove_channel_from_dynamic_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_remove_channel_from_dynamic_playable")));
+
+    if (!Api->IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to resolve haptic API functions."));
+    }
+}
+
+std::uint64_t TsHapticPlayablePool::CreatePlayable(void* DeviceHandle, void* AssetHandle)
+{
+    if (Api->CreateFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to create playable - null ts_haptic_create_playable_from_asset handle."));
+        return 0;
+    }
+    std::uint64_t PlayableId = 0;
+    auto StatusCode = Api->CreateFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), reinterpret_cast<TsAsset*>(AssetHandle), false, &PlayableId);
+    if (StatusCode != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticPlayablePool: failed to create playable - code: %i."), StatusCode);
+        return 0;
+    }
+    ++Counters.Created;
+    return PlayableId;
+}
+
+void TsHapticPlayablePool::Recycle(void* DeviceHandle, DevicePool& Pool)
+{
+    if (Api->IsPlayingFn == nullptr)
+    {
+        return;
+    }
+
+    // Return finished auto released playables to the pool
+    auto Device = reinterpret_cast<TsDeviceHandle*>(DeviceHandle);
+    for (auto& It : Pool.Playables)
+    {
+        auto& Item = It.second;
+        if (!Item.bInUse || !Item.bReleaseOnFinish)
+        {
+            continue;
+        }
+        bool bPlaying = true;
+        if (Api->IsPlayingFn(Device, It.first, &bPlaying) == 0 && !bPlaying)
+        {
+            ReturnToPool(Pool, It.first, Item);
+            ++Counters.Recycled;
+        }
+    }
+}
+
+void TsHapticPlayablePool::ReturnToPool(DevicePool& Pool, std::uint64_t PlayableId, Playable& Item)
+{
+    Item.bInUse = false;
+    Item.bReleaseOnFinish = false;
+    Pool.FreeIds[Item.AssetHandle].push_back(PlayableId);
+}
+
+TsHapticPlayablePool::Playable* TsHapticPlayablePool::FindPlayable(void* DeviceHandle, std::uint64_t PlayableId)
+{
+    auto PoolIt = Pools.find(DeviceHandle);
+    if (PoolIt == Pools.end())
+    {
+        return nullptr;
+    }
+    auto It = PoolIt->second.Playables.find(PlayableId);
+    return It != PoolIt->second.Playables.end() && It->second.bInUse ? &It->second : nullptr;
+}
@@ -1,8 +1,30 @@
 #include "Haptic/TsHapticPlayer.h"
+#include <atomic>
 #include "ITeslasuitPlugin.h"
 #include "Haptic/TsHapticAssetManager.h"
+#include "Haptic/TsHapticPlayablePool.h"
+#include "Haptic/TsHapticThread.h"
+#include "GameFramework/Actor.h"
 #include "ts_api/ts_haptic_api.h"
 
+struct UTsHapticPlayer::SnapshotRequest
+{
+    decltype(&ts_haptic_is_playable_playing) IsPlayingFn = nullptr;
+    decltype(&ts_haptic_get_playable_local_time) GetLocalTimeFn = nullptr;
+    decltype(&ts_haptic_get_playable_duration) GetDurationFn = nullptr;
+    TsDeviceHandle* Device = nullptr;
+
+    // Written by game thread while request is idle
+    std::vector<std::uint64_t> Ids;
+    std::vector<uint32> Generations;
+
+    // Written by haptic thread while request is in flight, durations are kept between requests
+    std::vector<PlayableState> Results;
+    bool bReady = false;
+
+    std::atomic_bool bInFlight = false;
+};
+
 UTsHapticPlayer::UTsHapticPlayer()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -13,23 +35,25 @@ void UTsHapticPlayer::BeginPlay()
 	Super::BeginPlay();
 
     LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
+
+    // Read playlist payloads in background before device is set
+    for (auto& Asset : Playlist)
+    {
+        if (Asset != nullptr)
+        {
+            Asset->PreloadPayload();
+        }
+    }
     UE_LOG(LogTemp, Log, TEXT("UTsHapticPlayer: begin play."));
 }
 
 void UTsHapticPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (Device->Handle == nullptr)
+    if (Device != nullptr && Device->Handle != nullptr)
     {
-        return;
-    }
-
-    // Remove playables and unload assets
-    for (auto& Asset : Playlist)
-    {
-		auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
-		AM.RemovePlayable(Device->Handle, PlayableIds[Asset->GetUniqueID()]);
-        AM.UnloadAsset(*Asset);
+        ReleasePlayables();
     }
+    Request.reset();
     UE_LOG(LogTemp, Log, TEXT("UTsHapticPlayer: end play."));
     Super::EndPlay(EndPlayReason);
 }
@@ -37,10 +61,21 @@ void UTsHapticPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UTsHapticPlayer::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    // Voices are shared by all players, manager updates them once per frame
+    ITeslasuitPlugin::Get().GetHapticVoiceManager().Update();
+
+    ApplySnapshot();
+    RequestSnapshot();
 }
 
 void UTsHapticPlayer::SetTsDevice(UTsDevice* Device_)
 {
+    // Playables belong to the previous device, release them before switching
+    if (Device != nullptr && Device->Handle != nullptr)
+    {
+        ReleasePlayables();
+    }
 	Device = Device_;
     if (Device != nullptr && Playlist.Num() > 0)
     {
@@ -48,7 +83,17 @@ void UTsHapticPlayer::SetTsDevice(UTsDevice* Device_)
     }
 }
 
+UTsDevice* UTsHapticPlayer::GetTsDevice() const
+{
+    return Device;
+}
+
 void UTsHapticPlayer::Play(int Index)
+{
+    PlayWithParams(Index, DefaultVoiceParams);
+}
+
+void UTsHapticPlayer::PlayWithParams(int Index, const FTsHapticVoiceParams& Params)
 {
     UE_LOG(LogTemp, Log, TEXT("UTsHapticPlayer: play haptic."));
 
@@ -66,15 +111,24 @@ void UTsHapticPlayer::Play(int Index)
         return;
     }
 
-	// Play asset
-    auto PlayFn = reinterpret_cast<decltype(&ts_haptic_play_playable)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
-    if (PlayFn == nullptr)
+	// Play asset through voice manager
+    const auto& Asset = Playlist[Index];
+    const auto PlayableId = PlayableIds[Asset->GetUniqueID()];
+    if (!ITeslasuitPlugin::Get().GetHapticVoiceManager().Play(Device->Handle, PlayableId, Params, Asset->GetDuration()))
     {
-        UE_LOG(LogTemp, Error, TEXT("UTsHapticPlayer: failed to play asset - null ts_haptic_play_playable handle."));
-        return;
+        UE_LOG(LogTemp, Verbose, TEXT("UTsHapticPlayer: asset is virtualized - device voices are busy."));
     }
-    const auto PlayableId = PlayableIds[Playlist[Index]->GetUniqueID()];
-	PlayFn(reinterpret_cast<TsDeviceHandle*>(Device->Handle), PlayableId);
+    // Virtual voice keeps its timeline, so the asset counts as playing until the voice finishes
+    MarkPlaying(Index, true);
+}
+
+void UTsHapticPlayer::PlayAtLocation(int Index, FVector Location, ETsHapticPriority Priority, float Importance)
+{
+    FTsHapticVoiceParams Params;
+    Params.Priority = Priority;
+    Params.Importance = Importance;
+    Params.Distance = GetOwner() != nullptr ? FVector::Dist(GetOwner()->GetActorLocation(), Location) : 0.0f;
+    PlayWithParams(Index, Params);
 }
 
 void UTsHapticPlayer::Stop(int Index)
@@ -103,7 +157,9 @@ void UTsHapticPlayer::Stop(int Index)
         return;
     }
     const auto PlayableId = PlayableIds[Playlist[Index]->GetUniqueID()];
+    ITeslasuitPlugin::Get().GetHapticVoiceManager().Stop(Device->Handle, PlayableId);
     StopFn(reinterpret_cast<TsDeviceHandle*>(Device->Handle), PlayableId);
+    MarkPlaying(Index, false);
 }
 
 void UTsHapticPlayer::StopPlayer()
@@ -124,16 +180,186 @@ void UTsHapticPlayer::StopPlayer()
         UE_LOG(LogTemp, Error, TEXT("UTsHapticPlayer: failed to stop player - null ts_haptic_stop_player handle."));
         return;
     }
+    ITeslasuitPlugin::Get().GetHapticVoiceManager().StopDevice(Device->Handle);
     StopFn(reinterpret_cast<TsDeviceHandle*>(Device->Handle));
+    for (int Index = 0; Index < static_cast<int>(Snapshot.size()); ++Index)
+    {
+        MarkPlaying(Index, false);
+    }
+}
+
+FTsHapticVoiceStats UTsHapticPlayer::GetVoiceStats() const
+{
+    return ITeslasuitPlugin::Get().GetHapticVoiceManager().GetStats();
+}
+
+bool UTsHapticPlayer::IsPlaying(int Index) const
+{
+    return Index >= 0 && Index < static_cast<int>(Snapshot.size()) && Snapshot[Index].bPlaying;
+}
+
+float UTsHapticPlayer::GetPlaybackTime(int Index) const
+{
+    return Index >= 0 && Index < static_cast<int>(Snapshot.size()) ? Snapshot[Index].Time : 0.0f;
+}
+
+float UTsHapticPlayer::GetPlaybackDuration(int Index) const
+{
+    return Index >= 0 && Index < static_cast<int>(Snapshot.size()) ? Snapshot[Index].Duration : 0.0f;
+}
+
+float UTsHapticPlayer::GetPlaybackProgress(int Index) const
+{
+    const float Duration = GetPlaybackDuration(Index);
+    return Duration > 0.0f ? FMath::Clamp(GetPlaybackTime(Index) / Duration, 0.0f, 1.0f) : 0.0f;
 }
 
 void UTsHapticPlayer::InitializePlayables()
 {
-    // Load each asset from playlist, create playables and store their ids
+    // Load each asset from playlist, acquire pooled playables and store their ids
     auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    auto& Pool = ITeslasuitPlugin::Get().GetHapticPlayablePool();
     for (auto& Asset : Playlist)
     {
         auto AssetHandle = AM.LoadAsset(*Asset);
-        PlayableIds[Asset->GetUniqueID()] = AM.CreatePlayable(Device->Handle, AssetHandle);
+        PlayableIds[Asset->GetUniqueID()] = AssetHandle != nullptr ? Pool.Acquire(Device->Handle, AssetHandle) : 0;
+    }
+    ResetSnapshot();
+}
+
+void UTsHapticPlayer::ReleasePlayables()
+{
+    if (PlayableIds.empty())
+    {
+        return;
+    }
+
+    // Snapshot request in flight still queries the playables on haptic thread, let it finish first
+    if (Request != nullptr && Request->bInFlight.load(std::memory_order_acquire))
+    {
+        ITeslasuitPlugin::Get().GetHapticThread().Flush();
+    }
+
+    // Return playables to the pool and unload assets, each asset was loaded once by #InitializePlayables
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    auto& Pool = ITeslasuitPlugin::Get().GetHapticPlayablePool();
+    auto& VM = ITeslasuitPlugin::Get().GetHapticVoiceManager();
+    for (auto& Asset : Playlist)
+    {
+        VM.Stop(Device->Handle, PlayableIds[Asset->GetUniqueID()]);
+        Pool.Release(Device->Handle, PlayableIds[Asset->GetUniqueID()]);
+        AM.UnloadAsset(*Asset);
+    }
+    PlayableIds.clear();
+    Request.reset();
+}
+
+void UTsHapticPlayer::ResetSnapshot()
+{
+    Snapshot.assign(Playlist.Num(), PlayableState());
+    Generations.assign(Playlist.Num(), 0);
+
+    // Previous request may still be in flight, start with a new one
+    Request = std::make_shared<SnapshotRequest>();
+    Request->IsPlayingFn = reinterpret_cast<decltype(&ts_haptic_is_playable_playing)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_is_playable_playing")));
+    Request->GetLocalTimeFn = reinterpret_cast<decltype(&ts_haptic_get_playable_local_time)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_local_time")));
+    Request->GetDurationFn = reinterpret_cast<decltype(&ts_haptic_get_playable_duration)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_duration")));
+    Request->Device = Device != nullptr ? reinterpret_cast<TsDeviceHandle*>(Device->Handle) : nullptr;
+    Request->Results.assign(Playlist.Num(), PlayableState());
+    for (int Index = 0; Index < Playlist.Num(); ++Index)
+    {
+        const auto& Asset = Playlist[Index];
+        Request->Ids.push_back(Asset != nullptr ? PlayableIds[Asset->GetUniqueID()] : 0);
+
+        // Durations known from import are not queried from device, queried ones stay in the request
+        Request->Results[Index].Duration = Asset != nullptr ? Asset->GetDuration() : 0.0f;
+        Snapshot[Index].Duration = Request->Results[Index].Duration;
+    }
+}
+
+void UTsHapticPlayer::ApplySnapshot()
+{
+    if (Request == nullptr || Request->bInFlight.load(std::memory_order_acquire) || !Request->bReady)
+    {
+        return;
+    }
+    Request->bReady = false;
+
+    // Skip entries changed by Play or Stop after the request was sent
+    auto& VM = ITeslasuitPlugin::Get().GetHapticVoiceManager();
+    TArray<int32, TInlineAllocator<8>> Finished;
+    for (std::size_t Index = 0; Index < Snapshot.size(); ++Index)
+    {
+        if (Request->Generations[Index] != Generations[Index])
+        {
+            continue;
+        }
+        const bool bWasPlaying = Snapshot[Index].bPlaying;
+        Snapshot[Index] = Request->Results[Index];
+
+        // Stolen and virtual voices are silent on device but still on their timeline, only finished voices end playback
+        if (!Snapshot[Index].bPlaying && Request->Ids[Index] != 0 &&
+            VM.GetVoiceState(Request->Device, Request->Ids[Index]) != ETsHapticVoiceState::Finished)
+        {
+            Snapshot[Index].bPlaying = true;
+        }
+        if (bWasPlaying && !Snapshot[Index].bPlaying)
+        {
+            Finished.Add(static_cast<int32>(Index));
+        }
+    }
+    for (auto Index : Finished)
+    {
+        OnPlaybackFinished.Broadcast(Index);
+    }
+}
+
+void UTsHapticPlayer::RequestSnapshot()
+{
+    if (Request == nullptr || Request->Device == nullptr || Request->Ids.empty() || Request->bInFlight.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    if (Request->IsPlayingFn == nullptr || Request->GetLocalTimeFn == nullptr || Request->GetDurationFn == nullptr)
+    {
+        return;
+    }
+
+    // Query all playables in one batch on haptic thread
+    Request->Generations = Generations;
+    Request->bInFlight.store(true, std::memory_order_release);
+    ITeslasuitPlugin::Get().GetHapticThread().Enqueue([Data = Request]()
+    {
+        for (std::size_t Index = 0; Index < Data->Ids.size(); ++Index)
+        {
+            const auto Id = Data->Ids[Index];
+            auto& State = Data->Results[Index];
+            if (Id == 0)
+            {
+                continue;
+            }
+            bool bPlaying = false;
+            std::uint64_t LocalTime = 0;
+            State.bPlaying = Data->IsPlayingFn(Data->Device, Id, &bPlaying) == 0 && bPlaying;
+            State.Time = Data->GetLocalTimeFn(Data->Device, Id, &LocalTime) == 0 ? LocalTime / 1000.0f : 0.0f;
+            if (State.Duration == 0.0f)
+            {
+                std::uint64_t DurationMs = 0;
+                State.Duration = Data->GetDurationFn(Data->Device, Id, &DurationMs) == 0 ? DurationMs / 1000.0f : 0.0f;
+            }
+        }
+        Data->bReady = true;
+        Data->bInFlight.store(false, std::memory_order_release);
+    });
+}
+
+void UTsHapticPlayer::MarkPlaying(int Index, bool bPlaying)
+{
+    if (Index < 0 || Index >= static_cast<int>(Snapshot.size()))
+    {
+        return;
     }
+    Snapshot[Index].bPlaying = bPlaying;
+    Snapshot[Index].Time = 0.0f;
+    ++Generations[Index];
 }
@@ -0,0 +1,66 @@
+#include "Haptic/TsHapticThread.h"
+#include <future>
+#include "CoreMinimal.h"
+
+TsHapticThread::TsHapticThread()
+    : Thread{ &TsHapticThread::Run, this }
+{
+    UE_LOG(LogTemp, Log, TEXT("TsHapticThread: constructed."));
+}
+
+TsHapticThread::~TsHapticThread()
+{
+    // Stop thread, pending commands are executed before exit
+    {
+        std::lock_guard<std::mutex> Lock(QueueMutex);
+        bFinished = true;
+    }
+    QueueCondition.notify_one();
+    if (Thread.joinable())
+    {
+        Thread.join();
+    }
+    UE_LOG(LogTemp, Log, TEXT("TsHapticThread: deconstructed."));
+}
+
+void TsHapticThread::Enqueue(Command&& Cmd)
+{
+    {
+        std::lock_guard<std::mutex> Lock(QueueMutex);
+        Queue.push_back(std::move(Cmd));
+    }
+    QueueCondition.notify_one();
+}
+
+void TsHapticThread::Flush()
+{
+    // Commands run in order, so the marker runs after all earlier commands
+    auto Done = std::make_shared<std::promise<void>>();
+    auto Future = Done->get_future();
+    Enqueue([Done]() { Done->set_value(); });
+    Future.wait();
+}
+
+void TsHapticThread::Run()
+{
+    std::deque<Command> Batch;
+    while (true)
+    {
+        // Take all queued commands at once
+        {
+            std::unique_lock<std::mutex> Lock(QueueMutex);
+            QueueCondition.wait(Lock, [this]() { return bFinished || !Queue.empty(); });
+            if (Queue.empty() && bFinished)
+            {
+                return;
+            }
+            Batch.swap(Queue);
+        }
+
+        for (auto& Cmd : Batch)
+        {
+            Cmd();
+        }
+        Batch.clear();
+    }
+}
@@ -0,0 +1,330 @@
+#include "Haptic/TsHapticVoiceManager.h"
+#include <algorithm>
+#include <limits>
+#include "HAL/IConsoleManager.h"
+#include "TsStats.h"
+#include "ts_api/ts_haptic_api.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Haptic Voices Active"), STAT_TsHapticVoicesActive, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Haptic Voices Virtual"), STAT_TsHapticVoicesVirtual, STATGROUP_Teslasuit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Haptic Voices Stolen"), STAT_TsHapticVoicesStolen, STATGROUP_Teslasuit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Haptic Voices Virtualized"), STAT_TsHapticVoicesVirtualized, STATGROUP_Teslasuit);
+
+static TAutoConsoleVariable<int32> CVarTsHapticMaxVoices(
+    TEXT("Teslasuit.Haptic.MaxVoices"),
+    8,
+    TEXT("Maximum number of haptic playables playing simultaneously on a single device."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTsHapticVoiceDistanceScale(
+    TEXT("Teslasuit.Haptic.VoiceDistanceScale"),
+    1000.0f,
+    TEXT("Distance at which haptic voice importance is halved."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTsHapticVirtualVoiceTimeout(
+    TEXT("Teslasuit.Haptic.VirtualVoiceTimeout"),
+    5.0f,
+    TEXT("Seconds a virtual haptic voice of unknown duration waits for a free slot before it is dropped."),
+    ECVF_Default);
+
+namespace
+{
+    const double UnknownEndTime = std::numeric_limits<double>::max();
+    const double LatencySmoothing = 0.1;
+}
+
+struct TsHapticVoiceManager::ApiFunctions
+{
+    decltype(&ts_haptic_play_playable) PlayFn = nullptr;
+    decltype(&ts_haptic_stop_playable) StopFn = nullptr;
+    decltype(&ts_haptic_is_playable_playing) IsPlayingFn = nullptr;
+    decltype(&ts_haptic_get_playable_duration) GetDurationFn = nullptr;
+    decltype(&ts_haptic_set_playable_local_time) SetLocalTimeFn = nullptr;
+};
+
+TsHapticVoiceManager::TsHapticVoiceManager()
+    : Api(std::make_unique<ApiFunctions>())
+{
+    UE_LOG(LogTemp, Log, TEXT("TsHapticVoiceManager: constructed."));
+}
+
+TsHapticVoiceManager::~TsHapticVoiceManager()
+{
+    UE_LOG(LogTemp, Log, TEXT("TsHapticVoiceManager: deconstructed."));
+}
+
+bool TsHapticVoiceManager::Play(void* DeviceHandle, std::uint64_t PlayableId, const FTsHapticVoiceParams& Params, double Duration)
+{
+    if (!Admit(DeviceHandle, PlayableId, Params, Duration))
+    {
+        return false;
+    }
+    Api->PlayFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId);
+    return true;
+}
+
+bool TsHapticVoiceManager::Admit(void* DeviceHandle, std::uint64_t PlayableId, const FTsHapticVoiceParams& Params, double Duration)
+{
+    if (Api->PlayFn == nullptr || Api->StopFn == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsHapticVoiceManager: failed to play - null haptic API handle."));
+        return false;
+    }
+
+    // Replaying a playable restarts its voice
+    Stop(DeviceHandle, PlayableId);
+
+    const double Now = FPlatformTime::Seconds();
+    const float DistanceScale = FMath::Max(CVarTsHapticVoiceDistanceScale.GetValueOnGameThread(), KINDA_SMALL_NUMBER);
+    if (Duration <= 0.0)
+    {
+        Duration = GetDuration(DeviceHandle, PlayableId);
+    }
+
+    Voice NewVoice;
+    NewVoice.PlayableId = PlayableId;
+    NewVoice.Priority = Params.Priority;
+    NewVoice.Score = Params.Importance / (1.0f + Params.Distance / DistanceScale);
+    NewVoice.StartTime = Now;
+    NewVoice.EndTime = Duration > 0.0 ? Now + Duration : UnknownEndTime;
+    NewVoice.Sequence = NextSequence++;
+
+    auto& Voices = Devices[DeviceHandle];
+
+    // Free voice available
+    if (static_cast<int32>(Voices.Real.size()) < GetMaxVoices(Voices))
+    {
+        Voices.Real.push_back(NewVoice);
+        return true;
+    }
+
+    // Steal the weakest voice if the new one outranks it
+    auto Victim = std::min_element(Voices.Real.begin(), Voices.Real.end(), &TsHapticVoiceManager::IsLess);
+    if (Victim != Voices.Real.end() && (Victim->Priority < NewVoice.Priority ||
+        (Victim->Priority == NewVoice.Priority && Victim->Score < NewVoice.Score)))
+    {
+        Api->StopFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), Victim->PlayableId);
+        Victim->State = ETsHapticVoiceState::Stolen;
+        Voices.Virtual.push_back(*Victim);
+        ++Stats.Stolen;
+        INC_DWORD_STAT(STAT_TsHapticVoicesStolen);
+
+        *Victim = NewVoice;
+        return true;
+    }
+
+    // Keep the voice timeline until a slot frees up
+    NewVoice.State = ETsHapticVoiceState::Virtual;
+    Voices.Virtual.push_back(NewVoice);
+    ++Stats.Virtualized;
+    INC_DWORD_STAT(STAT_TsHapticVoicesVirtualized);
+    return false;
+}
+
+void TsHapticVoiceManager::Stop(void* DeviceHandle, std::uint64_t PlayableId)
+{
+    auto It = Devices.find(DeviceHandle);
+    if (It == Devices.end())
+    {
+        return;
+    }
+    auto ById = [PlayableId](const Voice& Item) { return Item.PlayableId == PlayableId; };
+    auto& Real = It->second.Real;
+    auto& Virtual = It->second.Virtual;
+    Real.erase(std::remove_if(Real.begin(), Real.end(), ById), Real.end());
+    Virtual.erase(std::remove_if(Virtual.begin(), Virtual.end(), ById), Virtual.end());
+}
+
+ETsHapticVoiceState TsHapticVoiceManager::GetVoiceState(void* DeviceHandle, std::uint64_t PlayableId) const
+{
+    auto It = Devices.find(DeviceHandle);
+    if (It == Devices.end())
+    {
+        return ETsHapticVoiceState::Finished;
+    }
+    auto ById = [PlayableId](const Voice& Item) { return Item.PlayableId == PlayableId; };
+    const auto& Real = It->second.Real;
+    const auto& Virtual = It->second.Virtual;
+    if (std::any_of(Real.begin(), Real.end(), ById))
+    {
+        return ETsHapticVoiceState::Playing;
+    }
+    auto VirtualIt = std::find_if(Virtual.begin(), Virtual.end(), ById);
+    return VirtualIt != Virtual.end() ? VirtualIt->State : ETsHapticVoiceState::Finished;
+}
+
+void TsHapticVoiceManager::StopDevice(void* DeviceHandle)
+{
+    auto It = Devices.find(DeviceHandle);
+    if (It != Devices.end())
+    {
+        It->second.Real.clear();
+        It->second.Virtual.clear();
+    }
+}
+
+void TsHapticVoiceManager::RemoveDevice(void* DeviceHandle)
+{
+    Devices.erase(DeviceHandle);
+    CommandLatencies.erase(DeviceHandle);
+    for (auto It = Durations.begin(); It != Durations.end();)
+    {
+        It = It->first.first == DeviceHandle ? Durations.erase(It) : std::next(It);
+    }
+}
+
+void TsHapticVoiceManager::Update()
+{
+    // Update once per frame regardless of number of callers
+    if (LastUpdateFrame == GFrameCounter)
+    {
+        return;
+    }
+    LastUpdateFrame = GFrameCounter;
+
+    const double Now = FPlatformTime::Seconds();
+    const double VirtualTimeout = FMath::Max(CVarTsHapticVirtualVoiceTimeout.GetValueOnGameThread(), 0.0f);
+    int32 ActiveCount = 0;
+    int32 VirtualCount = 0;
+    for (auto& It : Devices)
+    {
+        auto Device = reinterpret_cast<TsDeviceHandle*>(It.first);
+        auto& Voices = It.second;
+
+        // Expire finished voices
+        Voices.Real.erase(std::remove_if(Voices.Real.begin(), Voices.Real.end(), [this, Device, Now](const Voice& Item)
+        {
+            if (Item.EndTime != UnknownEndTime)
+            {
+                return Item.EndTime <= Now;
+            }
+            bool bPlaying = true;
+            return Api->IsPlayingFn != nullptr && Api->IsPlayingFn(Device, Item.PlayableId, &bPlaying) == 0 && !bPlaying;
+        }), Voices.Real.end());
+
+        // Virtual voices can't be polled on device, ones of unknown duration time out
+        const auto VirtualBefore = Voices.Virtual.size();
+        Voices.Virtual.erase(std::remove_if(Voices.Virtual.begin(), Voices.Virtual.end(), [Now, VirtualTimeout](const Voice& Item)
+        {
+            return Item.EndTime != UnknownEndTime ? Item.EndTime <= Now : Now - Item.StartTime >= VirtualTimeout;
+        }), Voices.Virtual.end());
+        Stats.Dropped += static_cast<int32>(VirtualBefore - Voices.Virtual.size());
+
+        // Resume the best virtual voices on free slots
+        const int32 MaxVoices = GetMaxVoices(Voices);
+        while (!Voices.Virtual.empty() && static_cast<int32>(Voices.Real.size()) < MaxVoices)
+        {
+            auto Best = std::max_element(Voices.Virtual.begin(), Voices.Virtual.end(), &TsHapticVoiceManager::IsLess);
+            Start(It.first, *Best, Now);
+            Best->State = ETsHapticVoiceState::Playing;
+            Voices.Real.push_back(*Best);
+            Voices.Virtual.erase(Best);
+            ++Stats.Revived;
+        }
+
+        ActiveCount += static_cast<int32>(Voices.Real.size());
+        VirtualCount += static_cast<int32>(Voices.Virtual.size());
+    }
+    Stats.Active = ActiveCount;
+    Stats.Virtual = VirtualCount;
+    SET_DWORD_STAT(STAT_TsHapticVoicesActive, ActiveCount);
+    SET_DWORD_STAT(STAT_TsHapticVoicesVirtual, VirtualCount);
+}
+
+void TsHapticVoiceManager::ReportCommandLatency(void* DeviceHandle, double Latency)
+{
+    // First sample is taken as is, next ones are smoothed
+    auto It = CommandLatencies.find(DeviceHandle);
+    if (It == CommandLatencies.end())
+    {
+        CommandLatencies.emplace(DeviceHandle, Latency);
+        return;
+    }
+    It->second += (Latency - It->second) * LatencySmoothing;
+}
+
+double TsHapticVoiceManager::GetCommandLatency(void* DeviceHandle) const
+{
+    auto It = CommandLatencies.find(DeviceHandle);
+    return It != CommandLatencies.end() ? It->second : 0.0;
+}
+
+void TsHapticVoiceManager::SetMaxVoices(void* DeviceHandle, int32 MaxVoices)
+{
+    Devices[DeviceHandle].MaxVoices = FMath::Max(MaxVoices, 0);
+}
+
+FTsHapticVoiceStats TsHapticVoiceManager::GetStats() const
+{
+    return Stats;
+}
+
+void TsHapticVoiceManager::SetLibHandle(void* Handle)
+{
+    LibHandle = Handle;
+
+    // Resolve functions once, voices are managed every frame
+    Api->PlayFn = reinterpret_cast<decltype(&ts_haptic_play_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
+    Api->StopFn = reinterpret_cast<decltype(&ts_haptic_stop_playable)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_stop_playable")));
+    Api->IsPlayingFn = reinterpret_cast<decltype(&ts_haptic_is_playable_playing)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_is_playable_playing")));
+    Api->GetDurationFn = reinterpret_cast<decltype(&ts_haptic_get_playable_duration)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_duration")));
+    Api->SetLocalTimeFn = reinterpret_cast<decltype(&ts_haptic_set_playable_local_time)>(
+        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_set_playable_local_time")));
+}
+
+bool TsHapticVoiceManager::IsLess(const Voice& Lhs, const Voice& Rhs)
+{
+    if (Lhs.Priority != Rhs.Priority)
+    {
+        return Lhs.Priority < Rhs.Priority;
+    }
+    if (Lhs.Score != Rhs.Score)
+    {
+        return Lhs.Score < Rhs.Score;
+    }
+    // Older voice is weaker, so it is stolen first and resumed last
+    return Lhs.Sequence < Rhs.Sequence;
+}
+
+double TsHapticVoiceManager::GetDuration(void* DeviceHandle, std::uint64_t PlayableId)
+{
+    const auto Key = std::make_pair(DeviceHandle, PlayableId);
+    auto It = Durations.find(Key);
+    if (It != Durations.end())
+    {
+        return It->second;
+    }
+
+    // Duration doesn't change, query it once per playable
+    uint64_t DurationMs = 0;
+    if (Api->GetDurationFn == nullptr || Api->GetDurationFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), PlayableId, &DurationMs) != 0)
+    {
+        DurationMs = 0;
+    }
+    const double Duration = DurationMs / 1000.0;
+    Durations[Key] = Duration;
+    return Duration;
+}
+
+void TsHapticVoiceManager::Start(void* DeviceHandle, const Voice& Item, double Now)
+{
+    auto Device = reinterpret_cast<TsDeviceHandle*>(DeviceHandle);
+
+    // Resumed voice continues from where its timeline is now
+    const double Elapsed = Now - Item.StartTime;
+    if (Elapsed > 0.0 && Api->SetLocalTimeFn != nullptr)
+    {
+        Api->SetLocalTimeFn(Device, Item.PlayableId, static_cast<uint64_t>(Elapsed * 1000.0));
+    }
+    Api->PlayFn(Device, Item.PlayableId);
+}
+
+int32 TsHapticVoiceManager::GetMaxVoices(const DeviceVoices& Voices) const
+{
+    return Voices.MaxVoices > 0 ? Voices.MaxVoices : FMath::Max(CVarTsHapticMaxVoices.GetValueOnGameThread(), 1);
+}
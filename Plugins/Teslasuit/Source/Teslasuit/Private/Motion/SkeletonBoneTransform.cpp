@@ -1,7 +1,12 @@
 #include "Motion/SkeletonBoneTransform.h"
+#include "Motion/TsMotionAnimation.h"
+#include "TsStats.h"
 
 #define LOCTEXT_NAMESPACE "Teslasuit"  
 
+DECLARE_CYCLE_STAT(TEXT("Mocap Anim Node Evaluate"), STAT_TsMocapNodeEvaluate, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mocap Anim Node Bones"), STAT_TsMocapNodeBones, STATGROUP_Teslasuit);
+
 
 FAnimNode_SkeletalBoneTransform::FAnimNode_SkeletalBoneTransform()
 {
@@ -14,15 +19,32 @@ void FAnimNode_SkeletalBoneTransform::GatherDebugData(FNodeDebugData & DebugData
 
 void FAnimNode_SkeletalBoneTransform::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext & Output, TArray<FBoneTransform>& OutBoneTransforms)
 {
+    SCOPE_CYCLE_COUNTER(STAT_TsMocapNodeEvaluate);
     check(OutBoneTransforms.Num() == 0);
+
+    // Detail level of the character limits applied bones
+    auto Animation = Cast<UTsMotionAnimation>(Output.AnimInstanceProxy->GetAnimInstanceObject());
+    const std::uint64_t EvaluatedBones = Animation != nullptr ? Animation->GetEvaluatedBones() : ~0ull;
+
+    if (Profile != nullptr)
+    {
+        EvaluateProfile(Output, Animation, EvaluatedBones);
+        return;
+    }
+
     TArray<FBoneTransform> bone_transform;
     bone_transform.Add(FBoneTransform());
     const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
 
     for (auto& object: BonesToModify)
     {
+        if ((EvaluatedBones & (1ull << static_cast<int32>(object.BoneIndex))) == 0)
+        {
+            continue;
+        }
         if (data.Contains(object.BoneIndex))
         {
+            INC_DWORD_STAT(STAT_TsMocapNodeBones);
             const auto transform = data[object.BoneIndex];
 
             FTransform component_transform = Output.AnimInstanceProxy->GetComponentTransform();
@@ -44,8 +66,51 @@ void FAnimNode_SkeletalBoneTransform::EvaluateSkeletalControl_AnyThread(FCompone
     }
 }
 
+void FAnimNode_SkeletalBoneTransform::EvaluateProfile(FComponentSpacePoseContext& Output, const UTsMotionAnimation* Animation, std::uint64_t EvaluatedBones)
+{
+    // Dense pose of motion animation is indexed directly, other sources go through data
+    const std::uint64_t PoseMask = Animation != nullptr ? Animation->GetPoseMask() : 0;
+    const FQuat4f* PoseRotations = Animation != nullptr ? Animation->GetPoseRotations() : nullptr;
+
+    TArray<FBoneTransform> BoneTransform;
+    BoneTransform.Add(FBoneTransform());
+    for (int32 Index = 0; Index < ProfileBones.Num(); ++Index)
+    {
+        const int32 MocapBone = ProfileMocapBones[Index];
+        const std::uint64_t Bit = 1ull << MocapBone;
+        if ((EvaluatedBones & Bit) == 0)
+        {
+            continue;
+        }
+
+        FQuat Rotation;
+        if ((PoseMask & Bit) != 0)
+        {
+            Rotation = FQuat(PoseRotations[MocapBone]);
+        }
+        else if (const FTransform* Transform = PoseMask == 0 ? data.Find(static_cast<FTsBoneIndex>(MocapBone)) : nullptr)
+        {
+            Rotation = Transform->GetRotation();
+        }
+        else
+        {
+            continue;
+        }
+        INC_DWORD_STAT(STAT_TsMocapNodeBones);
+
+        FTransform NewBone = Output.Pose.GetComponentSpaceTransform(ProfileBones[Index]);
+        NewBone.SetRotation(Rotation * ProfileOffsets[Index]);
+        BoneTransform[0] = FBoneTransform(ProfileBones[Index], NewBone);
+        Output.Pose.LocalBlendCSBoneTransforms(BoneTransform, 1.0f);
+    }
+}
+
 bool FAnimNode_SkeletalBoneTransform::IsValidToEvaluate(const USkeleton * Skeleton, const FBoneContainer & RequiredBones)
 {
+    if (Profile != nullptr)
+    {
+        return ProfileBones.Num() > 0;
+    }
     for (auto& bone : BonesToModify)
     {
         if (!bone.BoneRef.IsValidToEvaluate(RequiredBones))
@@ -54,8 +119,58 @@ bool FAnimNode_SkeletalBoneTransform::IsValidToEvaluate(const USkeleton * Skelet
     return true;
 }
 
+void FAnimNode_SkeletalBoneTransform::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+    Super::CacheBones_AnyThread(Context);
+
+    // Report mocap bones mapped to bones of current LOD, mocap streams only those
+    auto Animation = Cast<UTsMotionAnimation>(Context.AnimInstanceProxy->GetAnimInstanceObject());
+    if (Animation == nullptr)
+    {
+        return;
+    }
+    if (Profile != nullptr)
+    {
+        Animation->SetRequiredBones(this, ProfileMask);
+        return;
+    }
+    const auto& RequiredBones = Context.AnimInstanceProxy->GetRequiredBones();
+    std::uint64_t Mask = 0;
+    for (auto& object : BonesToModify)
+    {
+        if (object.BoneRef.IsValidToEvaluate(RequiredBones))
+        {
+            Mask |= 1ull << static_cast<int32>(object.BoneIndex);
+        }
+    }
+    Animation->SetRequiredBones(this, Mask);
+}
+
 void FAnimNode_SkeletalBoneTransform::InitializeBoneReferences(const FBoneContainer& RequiredBones)
 {
+    // Profile table of the skeleton is narrowed to bones of current LOD
+    ProfileBones.Reset();
+    ProfileMocapBones.Reset();
+    ProfileOffsets.Reset();
+    ProfileMask = 0;
+    if (Profile != nullptr)
+    {
+        if (const auto Table = Profile->GetTable(RequiredBones.GetSkeletonAsset()))
+        {
+            for (int32 Index = 0; Index < Table->SkeletonBones.Num(); ++Index)
+            {
+                const FCompactPoseBoneIndex Bone = RequiredBones.GetCompactPoseIndexFromSkeletonIndex(Table->SkeletonBones[Index]);
+                if (Bone.IsValid())
+                {
+                    ProfileBones.Add(Bone);
+                    ProfileMocapBones.Add(Table->MocapBones[Index]);
+                    ProfileOffsets.Add(Table->Offsets[Index]);
+                    ProfileMask |= 1ull << Table->MocapBones[Index];
+                }
+            }
+        }
+        return;
+    }
     for (auto& object: BonesToModify)
     {
         object.BoneRef.Initialize(RequiredBones);
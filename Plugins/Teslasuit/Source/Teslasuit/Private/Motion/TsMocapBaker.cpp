@@ -0,0 +1,337 @@
+#include "Motion/TsMocapBaker.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/Skeleton.h"
+#include "TsStats.h"
+#include "Runtime/Launch/Resources/Version.h"
+#if WITH_EDITOR
+#include "Animation/AnimData/IAnimationDataController.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "Teslasuit"
+
+DECLARE_CYCLE_STAT(TEXT("Mocap Bake Resample"), STAT_TsMocapBakeResample, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Mocap Bake Retarget"), STAT_TsMocapBakeRetarget, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Mocap Bake Reduce"), STAT_TsMocapBakeReduce, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Mocap Bake Create Asset"), STAT_TsMocapBakeCreateAsset, STATGROUP_Teslasuit);
+
+namespace
+{
+    // Keys retargeted by a single task, they share component space scratch
+    const int32 RetargetBatch = 64;
+
+    struct BakeTrack
+    {
+        FName Name;
+        int32 Bone = INDEX_NONE;
+        int32 MocapBone = 0;
+        FQuat Offset = FQuat::Identity;
+        /*! Component space rotation of each key. */
+        TArray<FQuat> Targets;
+        TArray<FVector3f> Positions;
+        TArray<FQuat4f> Rotations;
+        TArray<FVector3f> Scales;
+    };
+
+    struct BakeJob
+    {
+        TsMocapRecording Recording;
+        FReferenceSkeleton RefSkeleton;
+        FTsMocapBakeSettings Settings;
+        FString PackageName;
+        int32 NumKeys = 0;
+        TArray<BakeTrack> Tracks;
+    };
+
+    // Rotation of the bone in captured frame, frame must contain the bone
+    FQuat GetRotation(const TsMocapRecording& Recording, std::size_t Frame, int32 Bone)
+    {
+        const auto Below = Recording.Masks[Frame] & ((1ull << Bone) - 1);
+        return FQuat(Recording.Rotations[Recording.Offsets[Frame] + FMath::CountBits(Below)]);
+    }
+
+    void Resample(const TsMocapRecording& Recording, int32 FrameRate, int32 NumKeys, BakeTrack& Track)
+    {
+        const auto Bit = 1ull << Track.MocapBone;
+        const auto Num = Recording.Num();
+        const auto HasBone = [&Recording, Bit](std::size_t Frame) { return (Recording.Masks[Frame] & Bit) != 0; };
+
+        // Keys before the first capture of the bone hold its first rotation, keys after the last one hold the last
+        std::size_t First = 0;
+        while (!HasBone(First))
+        {
+            ++First;
+        }
+        std::size_t Previous = First;
+        std::size_t Next = First;
+        std::size_t Frame = 0;
+        Track.Targets.SetNumUninitialized(NumKeys);
+        for (int32 Key = 0; Key < NumKeys; ++Key)
+        {
+            const double Time = Recording.Times[0] + static_cast<double>(Key) / FrameRate;
+            while (Frame < Num && Recording.Times[Frame] <= Time)
+            {
+                Previous = HasBone(Frame) ? Frame : Previous;
+                ++Frame;
+            }
+            if (Next < Frame)
+            {
+                for (Next = Frame; Next < Num && !HasBone(Next); ++Next)
+                {
+                }
+            }
+
+            FQuat Rotation;
+            if (Next >= Num || Next == Previous)
+            {
+                Rotation = GetRotation(Recording, Previous, Track.MocapBone);
+            }
+            else
+            {
+                const double Span = Recording.Times[Next] - Recording.Times[Previous];
+                const double Alpha = Span > 0.0 ? FMath::Clamp((Time - Recording.Times[Previous]) / Span, 0.0, 1.0) : 1.0;
+                Rotation = FQuat::Slerp(GetRotation(Recording, Previous, Track.MocapBone), GetRotation(Recording, Next, Track.MocapBone), Alpha);
+            }
+            Track.Targets[Key] = Rotation * Track.Offset;
+        }
+    }
+
+    void Retarget(BakeJob& Job)
+    {
+        const auto& RefSkeleton = Job.RefSkeleton;
+        const auto& RefPose = RefSkeleton.GetRefBonePose();
+        const int32 NumBones = RefSkeleton.GetNum();
+
+        // Bones without track keep reference pose, only driven bones and their ancestors are evaluated
+        TArray<int32> TrackOfBone;
+        TrackOfBone.Init(INDEX_NONE, NumBones);
+        TArray<bool> Evaluated;
+        Evaluated.Init(false, NumBones);
+        int32 LastBone = INDEX_NONE;
+        for (int32 Index = 0; Index < Job.Tracks.Num(); ++Index)
+        {
+            auto& Track = Job.Tracks[Index];
+            TrackOfBone[Track.Bone] = Index;
+            LastBone = FMath::Max(LastBone, Track.Bone);
+            for (int32 Bone = Track.Bone; Bone != INDEX_NONE && !Evaluated[Bone]; Bone = RefSkeleton.GetParentIndex(Bone))
+            {
+                Evaluated[Bone] = true;
+            }
+            Track.Positions.SetNumUninitialized(Job.NumKeys);
+            Track.Rotations.SetNumUninitialized(Job.NumKeys);
+            Track.Scales.SetNumUninitialized(Job.NumKeys);
+        }
+
+        ParallelFor(FMath::DivideAndRoundUp(Job.NumKeys, RetargetBatch), [&Job, &RefSkeleton, &RefPose, &TrackOfBone, &Evaluated, LastBone](int32 Batch)
+        {
+            TArray<FTransform> ComponentSpace;
+            ComponentSpace.SetNumUninitialized(LastBone + 1);
+            const int32 End = FMath::Min((Batch + 1) * RetargetBatch, Job.NumKeys);
+            for (int32 Key = Batch * RetargetBatch; Key < End; ++Key)
+            {
+                // Parents precede children in reference skeleton
+                for (int32 Bone = 0; Bone <= LastBone; ++Bone)
+                {
+                    if (!Evaluated[Bone])
+                    {
+                        continue;
+                    }
+                    const int32 Parent = RefSkeleton.GetParentIndex(Bone);
+                    const FTransform& ParentSpace = Parent != INDEX_NONE ? ComponentSpace[Parent] : FTransform::Identity;
+                    ComponentSpace[Bone] = RefPose[Bone] * ParentSpace;
+
+                    const int32 TrackIndex = TrackOfBone[Bone];
+                    if (TrackIndex == INDEX_NONE)
+                    {
+                        continue;
+                    }
+                    // Same as anim node, rotation is set in component space and translation follows the parent
+                    auto& Track = Job.Tracks[TrackIndex];
+                    ComponentSpace[Bone].SetRotation(Track.Targets[Key]);
+                    const FTransform Local = ComponentSpace[Bone].GetRelativeTransform(ParentSpace);
+                    Track.Positions[Key] = FVector3f(Local.GetTranslation());
+                    Track.Rotations[Key] = FQuat4f(Local.GetRotation());
+                    Track.Scales[Key] = FVector3f(Local.GetScale3D());
+                }
+            }
+        });
+    }
+
+    void Reduce(BakeTrack& Track, float RotationTolerance, float TranslationTolerance)
+    {
+        Track.Targets.Empty();
+
+        // Keep neighbouring keys on the same hemisphere, so keys interpolate along the short arc
+        bool bConstant = true;
+        for (int32 Key = 1; Key < Track.Rotations.Num(); ++Key)
+        {
+            if ((Track.Rotations[Key] | Track.Rotations[Key - 1]) < 0.0f)
+            {
+                Track.Rotations[Key] = -Track.Rotations[Key];
+            }
+            bConstant = bConstant &&
+                Track.Rotations[0].AngularDistance(Track.Rotations[Key]) <= RotationTolerance &&
+                FVector3f::Dist(Track.Positions[0], Track.Positions[Key]) <= TranslationTolerance;
+        }
+        if (bConstant)
+        {
+            Track.Positions.SetNum(1);
+            Track.Rotations.SetNum(1);
+            Track.Scales.SetNum(1);
+        }
+    }
+
+    void Bake(BakeJob& Job)
+    {
+        {
+            SCOPE_CYCLE_COUNTER(STAT_TsMocapBakeResample);
+            ParallelFor(Job.Tracks.Num(), [&Job](int32 Index)
+            {
+                Resample(Job.Recording, Job.Settings.FrameRate, Job.NumKeys, Job.Tracks[Index]);
+            });
+        }
+        // Captured stream isn't needed anymore, release it before retarget allocates tracks
+        Job.Recording = TsMocapRecording();
+        {
+            SCOPE_CYCLE_COUNTER(STAT_TsMocapBakeRetarget);
+            Retarget(Job);
+        }
+        {
+            SCOPE_CYCLE_COUNTER(STAT_TsMocapBakeReduce);
+            const float RotationTolerance = FMath::DegreesToRadians(Job.Settings.RotationTolerance);
+            ParallelFor(Job.Tracks.Num(), [&Job, RotationTolerance](int32 Index)
+            {
+                Reduce(Job.Tracks[Index], RotationTolerance, Job.Settings.TranslationTolerance);
+            });
+        }
+    }
+
+    UAnimSequence* CreateSequence(BakeJob& Job, USkeleton* Skeleton)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_TsMocapBakeCreateAsset);
+#if WITH_EDITOR
+        UPackage* Package = CreatePackage(*Job.PackageName);
+        auto Sequence = NewObject<UAnimSequence>(Package, *FPackageName::GetShortName(Job.PackageName), RF_Public | RF_Standalone);
+        Sequence->SetSkeleton(Skeleton);
+
+        IAnimationDataController& Controller = Sequence->GetController();
+        Controller.OpenBracket(LOCTEXT("TsMocapBake", "Bake Teslasuit Mocap"), false);
+        Controller.ResetModel(false);
+        Controller.SetFrameRate(FFrameRate(Job.Settings.FrameRate, 1), false);
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2)
+        Controller.SetNumberOfFrames(FFrameNumber(Job.NumKeys - 1), false);
+#else
+        Controller.SetPlayLength(static_cast<float>(Job.NumKeys - 1) / Job.Settings.FrameRate, false);
+#endif
+        for (const auto& Track : Job.Tracks)
+        {
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2)
+            Controller.AddBoneCurve(Track.Name, false);
+#else
+            Controller.AddBoneTrack(Track.Name, false);
+#endif
+            Controller.SetBoneTrackKeys(Track.Name, Track.Positions, Track.Rotations, Track.Scales, false);
+        }
+        Controller.NotifyPopulated();
+        Controller.CloseBracket(false);
+
+        Sequence->MarkPackageDirty();
+        FAssetRegistryModule::AssetCreated(Sequence);
+        UE_LOG(LogTemp, Log, TEXT("TsMocapBaker: baked %d keys of %d bones into %s."), Job.NumKeys, Job.Tracks.Num(), *Job.PackageName);
+        return Sequence;
+#else
+        return nullptr;
+#endif
+    }
+
+    FString MakePackageName(const FTsMocapBakeSettings& Settings)
+    {
+        const FString AssetName = Settings.AssetName.IsEmpty() ? FDateTime::Now().ToString(TEXT("Mocap_%Y%m%d_%H%M%S")) : Settings.AssetName;
+        const FString BaseName = Settings.PackagePath / AssetName;
+        FString PackageName = BaseName;
+#if WITH_EDITOR
+        for (int32 Suffix = 1; FindPackage(nullptr, *PackageName) != nullptr || FPackageName::DoesPackageExist(PackageName); ++Suffix)
+        {
+            PackageName = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+        }
+#endif
+        return PackageName;
+    }
+}
+
+void TsMocapBaker::BakeAsync(TsMocapRecording&& Recording, TArray<BoneMapping>&& Bones, USkeleton* Skeleton,
+    const FTsMocapBakeSettings& Settings, Callback&& OnBaked)
+{
+#if !WITH_EDITOR
+    UE_LOG(LogTemp, Error, TEXT("TsMocapBaker: failed to bake mocap - animation assets can be created only in editor."));
+    OnBaked(nullptr);
+#else
+    if (Skeleton == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsMocapBaker: failed to bake mocap - no target skeleton."));
+        OnBaked(nullptr);
+        return;
+    }
+    if (Recording.Num() < 2)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsMocapBaker: failed to bake mocap - less than two frames captured."));
+        OnBaked(nullptr);
+        return;
+    }
+
+    auto Job = MakeShared<BakeJob, ESPMode::ThreadSafe>();
+    Job->RefSkeleton = Skeleton->GetReferenceSkeleton();
+    Job->Settings = Settings;
+    Job->Settings.FrameRate = FMath::Max(Settings.FrameRate, 1);
+    Job->PackageName = MakePackageName(Settings);
+    Job->NumKeys = FMath::FloorToInt32((Recording.Times.back() - Recording.Times.front()) * Job->Settings.FrameRate) + 1;
+
+    // Bones missing in skeleton or never captured are left out, last mapping of a bone wins like in anim node
+    std::uint64_t CapturedMask = 0;
+    for (const auto Mask : Recording.Masks)
+    {
+        CapturedMask |= Mask;
+    }
+    for (const auto& Mapping : Bones)
+    {
+        const int32 Bone = Job->RefSkeleton.FindBoneIndex(Mapping.Bone);
+        if (Bone == INDEX_NONE || (CapturedMask & (1ull << Mapping.MocapBone)) == 0)
+        {
+            continue;
+        }
+        Job->Tracks.RemoveAll([Bone](const BakeTrack& Track) { return Track.Bone == Bone; });
+        auto& Track = Job->Tracks.AddDefaulted_GetRef();
+        Track.Name = Mapping.Bone;
+        Track.Bone = Bone;
+        Track.MocapBone = Mapping.MocapBone;
+        Track.Offset = Mapping.Offset;
+    }
+    if (Job->NumKeys < 2 || Job->Tracks.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsMocapBaker: failed to bake mocap - capture is shorter than a frame or has no mapped bones."));
+        OnBaked(nullptr);
+        return;
+    }
+    Job->Recording = MoveTemp(Recording);
+
+    Async(EAsyncExecution::ThreadPool, [Job, WeakSkeleton = TWeakObjectPtr<USkeleton>(Skeleton), OnBaked = MoveTemp(OnBaked)]() mutable
+    {
+        Bake(*Job);
+        AsyncTask(ENamedThreads::GameThread, [Job, WeakSkeleton, OnBaked = MoveTemp(OnBaked)]()
+        {
+            USkeleton* Skeleton = WeakSkeleton.Get();
+            if (Skeleton == nullptr)
+            {
+                UE_LOG(LogTemp, Error, TEXT("TsMocapBaker: failed to bake mocap - target skeleton was destroyed."));
+            }
+            OnBaked(Skeleton != nullptr ? CreateSequence(*Job, Skeleton) : nullptr);
+        });
+    });
+#endif
+}
+
+#undef LOCTEXT_NAMESPACE
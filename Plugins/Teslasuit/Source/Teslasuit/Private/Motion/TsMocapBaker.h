@@ -0,0 +1,42 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Motion/TsMocapCapture.h"
+#include "Motion/TsMocapRecorder.h"
+
+class USkeleton;
+class UAnimSequence;
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Bakes captured mocap into animation sequence of a skeleton.
+
+    Resampling, retargeting and key reduction run on worker threads,
+    only creation of the asset itself is left to the game thread.
+*/
+class TsMocapBaker
+{
+public:
+    /*!
+        \brief Skeleton bone driven by mocap bone, offset is applied in component space like in anim node.
+    */
+    struct BoneMapping
+    {
+        FName Bone;
+        int32 MocapBone = 0;
+        FQuat Offset = FQuat::Identity;
+    };
+
+    using Callback = TUniqueFunction<void(UAnimSequence*)>;
+
+    /*!
+        \brief Starts baking, callback is called on game thread with created sequence or nullptr on failure.
+    */
+    static void BakeAsync(TsMocapRecording&& Recording, TArray<BoneMapping>&& Bones, USkeleton* Skeleton,
+        const FTsMocapBakeSettings& Settings, Callback&& OnBaked);
+};
+
+/**@}*/
@@ -0,0 +1,111 @@
+#include "Motion/TsMocapConvert.h"
+#include <vector>
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+#include "Motion/TsMocapFrame.h"
+
+static_assert(sizeof(TsMocapBone) == 28, "TsMocapBone is expected to be packed position and rotation.");
+
+void TsMocapConvert::ConvertBones(const TsMocapBone* Bones, std::uint64_t Mask, const FQuat4f* RotationOffsets,
+    FQuat4f* OutRotations, FVector4f* OutTranslations)
+{
+    // (x, y, z, rw) -> (x, z, -y, 0)
+    const VectorRegister4Float TranslationSigns = MakeVectorRegisterFloat(1.0f, 1.0f, -1.0f, 0.0f);
+    // (w, x, y, z) -> (x, z, -y, w)
+    const VectorRegister4Float RotationSigns = MakeVectorRegisterFloatMask(0, 0, 0x80000000, 0);
+
+    for (; Mask != 0; Mask &= Mask - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Mask);
+        const auto& Bone = Bones[Index];
+
+        // Both loads stay inside the packed 28 byte bone
+        const VectorRegister4Float Position = VectorLoad(&Bone.position.x);
+        const VectorRegister4Float Rotation = VectorLoad(&Bone.rotation.w);
+
+        const VectorRegister4Float Translation = VectorMultiply(VectorSwizzle(Position, 0, 2, 1, 3), TranslationSigns);
+        VectorRegister4Float Quat = VectorBitwiseXor(VectorSwizzle(Rotation, 1, 3, 2, 0), RotationSigns);
+        if (RotationOffsets != nullptr)
+        {
+            Quat = VectorQuaternionMultiply2(Quat, VectorLoadAligned(&RotationOffsets[Index].X));
+        }
+
+        VectorStoreAligned(Translation, &OutTranslations[Index].X);
+        VectorStoreAligned(Quat, &OutRotations[Index].X);
+    }
+}
+
+void TsMocapConvert::ConvertBonesScalar(const TsMocapBone* Bones, std::uint64_t Mask, const FQuat4f* RotationOffsets,
+    FQuat4f* OutRotations, FVector4f* OutTranslations)
+{
+    for (; Mask != 0; Mask &= Mask - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Mask);
+        const auto& Bone = Bones[Index];
+        OutTranslations[Index] = FVector4f(Bone.position.x, Bone.position.z, -Bone.position.y, 0.0f);
+        OutRotations[Index] = FQuat4f(Bone.rotation.x, Bone.rotation.z, -Bone.rotation.y, Bone.rotation.w);
+        if (RotationOffsets != nullptr)
+        {
+            OutRotations[Index] = OutRotations[Index] * RotationOffsets[Index];
+        }
+    }
+}
+
+namespace
+{
+    void BenchmarkConvert(const TArray<FString>& Args)
+    {
+        const int32 Suits = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+        const bool bOffsets = Args.Num() > 2 && FCString::Atoi(*Args[2]) != 0;
+        const auto BonesCount = TsMocapFrame::BonesCount;
+        const std::uint64_t Mask = (1ull << BonesCount) - 1;
+
+        FRandomStream Random(BonesCount);
+        std::vector<TsMocapBone> Bones(static_cast<std::size_t>(Suits * BonesCount));
+        for (auto& Bone : Bones)
+        {
+            const FQuat4f Quat(FRotator3f(Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f)));
+            Bone.position = { Random.FRand(), Random.FRand(), Random.FRand() };
+            Bone.rotation = { Quat.W, Quat.X, Quat.Y, Quat.Z };
+        }
+        std::vector<FQuat4f> Offsets(BonesCount, FQuat4f(FRotator3f(0.0f, 90.0f, 0.0f)));
+        std::vector<TsMocapFrame> Frames(static_cast<std::size_t>(Suits));
+        std::vector<TsMocapFrame> Reference(static_cast<std::size_t>(Suits));
+        const FQuat4f* OffsetsData = bOffsets ? Offsets.data() : nullptr;
+
+        auto Measure = [&](auto Convert, std::vector<TsMocapFrame>& Out)
+        {
+            const double Start = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                for (int32 Suit = 0; Suit < Suits; ++Suit)
+                {
+                    Convert(&Bones[Suit * BonesCount], Mask, OffsetsData, Out[Suit].Rotations, Out[Suit].Translations);
+                }
+            }
+            return (FPlatformTime::Seconds() - Start) * 1.0e9 / Iterations;
+        };
+        const double ScalarNs = Measure(&TsMocapConvert::ConvertBonesScalar, Reference);
+        const double VectorNs = Measure(&TsMocapConvert::ConvertBones, Frames);
+
+        float MaxError = 0.0f;
+        for (int32 Suit = 0; Suit < Suits; ++Suit)
+        {
+            for (int32 Bone = 0; Bone < BonesCount; ++Bone)
+            {
+                MaxError = FMath::Max(MaxError, FVector3f(Frames[Suit].Translations[Bone] - Reference[Suit].Translations[Bone]).GetAbsMax());
+                MaxError = FMath::Max(MaxError, Frames[Suit].Rotations[Bone].AngularDistance(Reference[Suit].Rotations[Bone]));
+            }
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("TsMocapConvert: %d bones x %d suits, offsets %s: scalar %.1f ns, vector %.1f ns per update of all suits (%.2fx), max error %g."),
+            BonesCount, Suits, bOffsets ? TEXT("on") : TEXT("off"), ScalarNs, VectorNs, VectorNs > 0.0 ? ScalarNs / VectorNs : 0.0, MaxError);
+    }
+}
+
+static FAutoConsoleCommand TsMocapBenchmarkConvertCommand(
+    TEXT("Teslasuit.Mocap.BenchmarkConvert"),
+    TEXT("Measures mocap bone conversion cost per frame. Arguments: [Suits=1] [Iterations=10000] [Offsets=0]."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkConvert));
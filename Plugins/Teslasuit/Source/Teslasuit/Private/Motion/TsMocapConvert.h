@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "ts_api/ts_types.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Conversion of device bones to UE coordinates.
+
+    Device bones are converted as translation (x, z, -y) and rotation (x, z, -y, w).
+    Output is written into separate rotation and translation streams indexed by bone,
+    only bones set in Mask are touched.
+*/
+namespace TsMocapConvert
+{
+    /*!
+        \brief Converts bones with vector shuffles and sign masks.
+
+        If RotationOffsets is not null, each converted rotation is multiplied by the offset
+        of its bone in the same pass, offsets are applied in bone local space.
+    */
+    void ConvertBones(const TsMocapBone* Bones, std::uint64_t Mask, const FQuat4f* RotationOffsets,
+        FQuat4f* OutRotations, FVector4f* OutTranslations);
+
+    /*!
+        \brief Reference per-component conversion, used to validate and benchmark #ConvertBones.
+    */
+    void ConvertBonesScalar(const TsMocapBone* Bones, std::uint64_t Mask, const FQuat4f* RotationOffsets,
+        FQuat4f* OutRotations, FVector4f* OutTranslations);
+}
+
+/**@}*/
@@ -0,0 +1,170 @@
+#include "Motion/TsMocapFilter.h"
+#include <vector>
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    // Smoothing factor of first order low-pass filter with given cutoff
+    float GetAlpha(float Cutoff, float Dt)
+    {
+        const float Tau = 1.0f / (2.0f * PI * Cutoff);
+        return Dt / (Dt + Tau);
+    }
+
+    float GetLength(const VectorRegister4Float& Value)
+    {
+        float Length;
+        VectorStoreFloat1(VectorSqrt(VectorDot4(Value, Value)), &Length);
+        return Length;
+    }
+
+    VectorRegister4Float Smooth(const VectorRegister4Float& Value, const VectorRegister4Float& Previous, VectorRegister4Float& Speed,
+        const TsMocapFilterParams& Params, int32 Bone, float Dt)
+    {
+        float Cutoff = Params.MinCutoff[Bone];
+        if (Params.Type == ETsMocapFilterType::OneEuro)
+        {
+            // Cutoff follows filtered speed, fast motion is smoothed less
+            const VectorRegister4Float RawSpeed = VectorMultiply(VectorSubtract(Value, Previous), VectorSetFloat1(1.0f / Dt));
+            Speed = VectorMultiplyAdd(VectorSubtract(RawSpeed, Speed), VectorSetFloat1(GetAlpha(Params.DerivativeCutoff[Bone], Dt)), Speed);
+            Cutoff += Params.Beta[Bone] * GetLength(Speed);
+        }
+        return VectorMultiplyAdd(VectorSubtract(Value, Previous), VectorSetFloat1(GetAlpha(Cutoff, Dt)), Previous);
+    }
+}
+
+std::shared_ptr<const TsMocapFilterParams> TsMocapFilterParams::Create(const UTsMocapFilterSettings* Settings)
+{
+    if (Settings == nullptr || Settings->FilterType == ETsMocapFilterType::None)
+    {
+        return nullptr;
+    }
+
+    auto Params = std::make_shared<TsMocapFilterParams>();
+    Params->Type = Settings->FilterType;
+    for (int32 Bone = 0; Bone < TsMocapFrame::BonesCount; ++Bone)
+    {
+        const auto Filter = Settings->BoneFilters.Find(static_cast<FTsBoneIndex>(Bone));
+        const auto& Source = Filter != nullptr ? *Filter : Settings->DefaultFilter;
+        Params->MinCutoff[Bone] = FMath::Max(Source.MinCutoff, 0.01f);
+        Params->Beta[Bone] = FMath::Max(Source.Beta, 0.0f);
+        Params->DerivativeCutoff[Bone] = FMath::Max(Source.DerivativeCutoff, 0.01f);
+    }
+    return Params;
+}
+
+void TsMocapFilter::SetParams(std::shared_ptr<const TsMocapFilterParams> Params_)
+{
+    Params = std::move(Params_);
+    Reset();
+}
+
+void TsMocapFilter::Reset()
+{
+    FilteredMask = 0;
+    LastTime = 0.0;
+}
+
+void TsMocapFilter::Apply(TsMocapFrame& Frame)
+{
+    if (Params == nullptr)
+    {
+        return;
+    }
+
+    // Device time follows sampling when known, arrival time is bursty; repeated timestamps carry no time step to filter with
+    const double SampleTime = Frame.DeviceTime > 0.0 ? Frame.DeviceTime : Frame.CaptureTime;
+    const float Dt = static_cast<float>(SampleTime - LastTime);
+    const bool bHistory = FilteredMask != 0 && Dt > 0.0f;
+    LastTime = SampleTime;
+
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+    {
+        const auto Bone = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+        VectorRegister4Float Rotation = VectorLoadAligned(&Frame.Rotations[Bone].X);
+        VectorRegister4Float Translation = VectorLoadAligned(&Frame.Translations[Bone].X);
+
+        if (bHistory && (FilteredMask & (1ull << Bone)) != 0)
+        {
+            const VectorRegister4Float PreviousRotation = VectorLoadAligned(&Rotations[Bone].X);
+            VectorRegister4Float RotationSpeed = VectorLoadAligned(&RotationSpeeds[Bone].X);
+            VectorRegister4Float TranslationSpeed = VectorLoadAligned(&TranslationSpeeds[Bone].X);
+
+            // Keep rotation on the same hemisphere as history, q and -q are the same rotation
+            const VectorRegister4Float Sign = VectorSelect(VectorCompareLT(VectorDot4(Rotation, PreviousRotation), Zero), VectorSetFloat1(-1.0f), VectorOneFloat());
+            Rotation = VectorMultiply(Rotation, Sign);
+
+            Rotation = VectorNormalizeQuaternion(Smooth(Rotation, PreviousRotation, RotationSpeed, *Params, Bone, Dt));
+            Translation = Smooth(Translation, VectorLoadAligned(&Translations[Bone].X), TranslationSpeed, *Params, Bone, Dt);
+
+            VectorStoreAligned(RotationSpeed, &RotationSpeeds[Bone].X);
+            VectorStoreAligned(TranslationSpeed, &TranslationSpeeds[Bone].X);
+            VectorStoreAligned(Rotation, &Frame.Rotations[Bone].X);
+            VectorStoreAligned(Translation, &Frame.Translations[Bone].X);
+        }
+        else
+        {
+            VectorStoreAligned(Zero, &RotationSpeeds[Bone].X);
+            VectorStoreAligned(Zero, &TranslationSpeeds[Bone].X);
+        }
+        VectorStoreAligned(Rotation, &Rotations[Bone].X);
+        VectorStoreAligned(Translation, &Translations[Bone].X);
+    }
+    // Bones left out of the frame restart their history once streamed again
+    FilteredMask = Frame.BoneMask;
+}
+
+namespace
+{
+    void BenchmarkFilter(const TArray<FString>& Args)
+    {
+        const int32 Suits = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 8;
+        const int32 Iterations = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+        const std::uint64_t Mask = (1ull << TsMocapFrame::BonesCount) - 1;
+
+        auto Settings = NewObject<UTsMocapFilterSettings>();
+        const auto Params = TsMocapFilterParams::Create(Settings);
+
+        FRandomStream Random(TsMocapFrame::BonesCount);
+        std::vector<TsMocapFrame> Frames(static_cast<std::size_t>(Suits));
+        std::vector<TsMocapFilter> Filters(static_cast<std::size_t>(Suits));
+        for (auto& Filter : Filters)
+        {
+            Filter.SetParams(Params);
+        }
+
+        double Elapsed = 0.0;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            // Fill frames with jittered poses like sensors at 100 Hz
+            for (auto& Frame : Frames)
+            {
+                Frame.BoneMask = Mask;
+                Frame.CaptureTime = Iteration * 0.01;
+                for (int32 Bone = 0; Bone < TsMocapFrame::BonesCount; ++Bone)
+                {
+                    Frame.Rotations[Bone] = FQuat4f(FRotator3f(Random.FRandRange(-1.0f, 1.0f), static_cast<float>(Bone), 0.0f));
+                    Frame.Translations[Bone] = FVector4f(Random.FRand(), Random.FRand(), Random.FRand(), 0.0f);
+                }
+            }
+
+            const double Start = FPlatformTime::Seconds();
+            for (int32 Suit = 0; Suit < Suits; ++Suit)
+            {
+                Filters[Suit].Apply(Frames[Suit]);
+            }
+            Elapsed += FPlatformTime::Seconds() - Start;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("TsMocapFilter: %d bones x %d suits: %.2f us per sample of all suits."),
+            TsMocapFrame::BonesCount, Suits, Elapsed * 1.0e6 / Iterations);
+    }
+}
+
+static FAutoConsoleCommand TsMocapBenchmarkFilterCommand(
+    TEXT("Teslasuit.Mocap.BenchmarkFilter"),
+    TEXT("Measures One-Euro filtering cost per sample. Arguments: [Suits=8] [Iterations=10000]."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkFilter));
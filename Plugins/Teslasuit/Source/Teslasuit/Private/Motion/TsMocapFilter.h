@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "Motion/TsMocapFrame.h"
+#include "Motion/TsMocapFilterSettings.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Filter parameters of all bones, immutable once built.
+*/
+struct TsMocapFilterParams
+{
+    ETsMocapFilterType Type = ETsMocapFilterType::None;
+    float MinCutoff[TsMocapFrame::BonesCount];
+    float Beta[TsMocapFrame::BonesCount];
+    float DerivativeCutoff[TsMocapFrame::BonesCount];
+
+    /*!
+        \brief Builds parameters from data asset, returns nullptr if filtering is disabled.
+    */
+    static std::shared_ptr<const TsMocapFilterParams> Create(const UTsMocapFilterSettings* Settings);
+};
+
+/*!
+    \brief Smoothing stage of mocap stream.
+
+    Filters rotations and translations of every bone in place, each bone is processed as
+    a 4 lane vector. Time step is taken from frame capture times, so filtering follows
+    the sensor rate. Must be used from a single thread.
+*/
+class TsMocapFilter
+{
+public:
+    /*!
+        \brief Sets parameters and restarts filtering.
+    */
+    void SetParams(std::shared_ptr<const TsMocapFilterParams> Params_);
+
+    /*!
+        \brief Current parameters, nullptr if filter is disabled.
+    */
+    const TsMocapFilterParams* GetParams() const { return Params.get(); }
+
+    /*!
+        \brief Forgets filtered history, next frame passes unchanged.
+    */
+    void Reset();
+
+    /*!
+        \brief Filters bones of the frame in place.
+    */
+    void Apply(TsMocapFrame& Frame);
+
+private:
+    std::shared_ptr<const TsMocapFilterParams> Params;
+    alignas(16) FQuat4f Rotations[TsMocapFrame::BonesCount];
+    alignas(16) FVector4f Translations[TsMocapFrame::BonesCount];
+    alignas(16) FQuat4f RotationSpeeds[TsMocapFrame::BonesCount];
+    alignas(16) FVector4f TranslationSpeeds[TsMocapFrame::BonesCount];
+    std::uint64_t FilteredMask = 0;
+    double LastTime = 0.0;
+};
+
+/**@}*/
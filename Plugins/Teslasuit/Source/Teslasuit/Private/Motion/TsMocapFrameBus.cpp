@@ -0,0 +1,82 @@
+#include "Motion/TsMocapFrameBus.h"
+
+TsMocapFrame& TsMocapFrameBus::BeginWrite()
+{
+    // Odd version marks slot as being written
+    const auto Index = Published.load(std::memory_order_relaxed);
+    auto& Target = Slots[Index % SlotsCount];
+    Target.Version.store(Index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Target.Frame.Sequence = Index;
+    return Target.Frame;
+}
+
+void TsMocapFrameBus::EndWrite()
+{
+    const auto Index = Published.load(std::memory_order_relaxed);
+    Slots[Index % SlotsCount].Version.store(Index * 2 + 2, std::memory_order_release);
+    Published.store(Index + 1, std::memory_order_release);
+}
+
+std::uint64_t TsMocapFrameBus::GetPublished() const
+{
+    return Published.load(std::memory_order_acquire);
+}
+
+TsMocapFrameBus::Reader::Reader(std::shared_ptr<const TsMocapFrameBus> Bus_)
+    : Bus(std::move(Bus_))
+    , Cursor(Bus->GetPublished())
+{
+}
+
+const TsMocapFrame* TsMocapFrameBus::Reader::BeginRead()
+{
+    for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+    {
+        const auto Available = Bus->GetPublished();
+        if (Cursor >= Available)
+        {
+            return nullptr;
+        }
+
+        // Slow reader, oldest unread frames are being overwritten
+        if (Available - Cursor >= SlotsCount)
+        {
+            Skipped += Available - 1 - Cursor;
+            Cursor = Available - 1;
+        }
+
+        const auto& Source = Bus->Slots[Cursor % SlotsCount];
+        ExpectedVersion = Cursor * 2 + 2;
+        if (Source.Version.load(std::memory_order_acquire) == ExpectedVersion)
+        {
+            return &Source.Frame;
+        }
+
+        // Overwritten right after publish check, retry with the latest frame
+        ++Torn;
+        Cursor = Bus->GetPublished() - 1;
+    }
+    return nullptr;
+}
+
+bool TsMocapFrameBus::Reader::EndRead()
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const bool bValid = Bus->Slots[Cursor % SlotsCount].Version.load(std::memory_order_relaxed) == ExpectedVersion;
+    if (!bValid)
+    {
+        ++Torn;
+    }
+    ++Cursor;
+    return bValid;
+}
+
+void TsMocapFrameBus::Reader::SkipToLatest()
+{
+    const auto Available = Bus->GetPublished();
+    if (Available > Cursor + 1)
+    {
+        Cursor = Available - 1;
+    }
+}
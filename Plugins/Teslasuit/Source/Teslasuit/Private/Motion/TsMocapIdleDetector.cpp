@@ -0,0 +1,45 @@
+#include "Motion/TsMocapIdleDetector.h"
+#include "Math/VectorRegister.h"
+
+void TsMocapIdleDetector::Reset()
+{
+    ReferenceMask = 0;
+}
+
+std::uint64_t TsMocapIdleDetector::Update(const TsMocapFrame& Frame, float AngleThreshold, float TranslationThreshold)
+{
+    bool bChanged = Frame.BoneMask != ReferenceMask || AngleThreshold <= 0.0f || TranslationThreshold <= 0.0f;
+    if (!bChanged)
+    {
+        // Smallest |dot| of rotations is the largest angular delta, largest squared distance of translations
+        VectorRegister4Float MinDot = VectorOneFloat();
+        VectorRegister4Float MaxDistance = VectorZeroFloat();
+        for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            const auto Bone = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+            const VectorRegister4Float Dot = VectorDot4(VectorLoadAligned(&Frame.Rotations[Bone].X), VectorLoadAligned(&Rotations[Bone].X));
+            const VectorRegister4Float Delta = VectorSubtract(VectorLoadAligned(&Frame.Translations[Bone].X), VectorLoadAligned(&Translations[Bone].X));
+            MinDot = VectorMin(MinDot, VectorAbs(Dot));
+            MaxDistance = VectorMax(MaxDistance, VectorDot3(Delta, Delta));
+        }
+
+        // Rotation by angle a has |dot| = cos(a / 2) with the reference
+        const VectorRegister4Float Outside = VectorBitwiseOr(
+            VectorCompareLT(MinDot, VectorSetFloat1(FMath::Cos(AngleThreshold * 0.5f))),
+            VectorCompareGT(MaxDistance, VectorSetFloat1(TranslationThreshold * TranslationThreshold)));
+        bChanged = VectorMaskBits(Outside) != 0;
+    }
+
+    if (bChanged)
+    {
+        for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            const auto Bone = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+            VectorStoreAligned(VectorLoadAligned(&Frame.Rotations[Bone].X), &Rotations[Bone].X);
+            VectorStoreAligned(VectorLoadAligned(&Frame.Translations[Bone].X), &Translations[Bone].X);
+        }
+        ReferenceMask = Frame.BoneMask;
+        ++Version;
+    }
+    return Version;
+}
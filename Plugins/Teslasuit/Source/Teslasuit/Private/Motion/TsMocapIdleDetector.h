@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "Motion/TsMocapFrame.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Detects mocap frames that don't change the pose.
+
+    Each frame is compared to the last changed pose, so slow drift still accumulates into
+    a change. Bones are compared as 4 lane vectors, angular delta of a bone is taken from
+    the dot product of its rotations. Must be used from a single thread.
+*/
+class TsMocapIdleDetector
+{
+public:
+    /*!
+        \brief Forgets reference pose, next frame is reported as changed.
+    */
+    void Reset();
+
+    /*!
+        \brief Returns pose version of the frame, incremented when any bone moved beyond thresholds.
+
+        AngleThreshold is in radians, TranslationThreshold in frame units.
+        Zero thresholds report every frame as changed.
+    */
+    std::uint64_t Update(const TsMocapFrame& Frame, float AngleThreshold, float TranslationThreshold);
+
+private:
+    alignas(16) FQuat4f Rotations[TsMocapFrame::BonesCount];
+    alignas(16) FVector4f Translations[TsMocapFrame::BonesCount];
+    std::uint64_t ReferenceMask = 0;
+    std::uint64_t Version = 0;
+};
+
+/**@}*/
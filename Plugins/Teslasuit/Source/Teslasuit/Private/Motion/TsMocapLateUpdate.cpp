@@ -0,0 +1,121 @@
+#include "Motion/TsMocapLateUpdate.h"
+#include "Components/SceneComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "SceneView.h"
+#include "TsStats.h"
+#include "Motion/TsMocapPredictor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mocap Late Update"), STAT_TsMocapLateUpdate, STATGROUP_Teslasuit);
+
+FTsMocapLateUpdate::FTsMocapLateUpdate(const FAutoRegister& AutoRegister, std::unique_ptr<TsMocapFrameBus::Reader> Reader_)
+    : FSceneViewExtensionBase(AutoRegister)
+    , Reader(std::move(Reader_))
+{
+}
+
+void FTsMocapLateUpdate::AddTarget(USceneComponent* Component, int32 Bone, FName MeshBone, const FQuat& Offset)
+{
+    if (Component == nullptr || Bone < 0 || Bone >= TsMocapFrame::BonesCount)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FTsMocapLateUpdate: failed to add target - invalid component or bone."));
+        return;
+    }
+
+    // Targets are read by render thread, change them only when it is idle
+    FlushRenderingCommands();
+    Targets.RemoveAll([Component](const TUniquePtr<Target>& Item) { return Item->Component.Get() == Component; });
+    auto NewTarget = MakeUnique<Target>();
+    NewTarget->Component = Component;
+    NewTarget->Bone = Bone;
+    NewTarget->MeshBone = MeshBone;
+    NewTarget->Offset = Offset;
+    Targets.Add(MoveTemp(NewTarget));
+}
+
+void FTsMocapLateUpdate::RemoveTarget(USceneComponent* Component)
+{
+    FlushRenderingCommands();
+    Targets.RemoveAll([Component](const TUniquePtr<Target>& Item) { return Item->Component.Get() == Component; });
+}
+
+void FTsMocapLateUpdate::Update_GameThread(const USkeletalMeshComponent& Mesh, std::uint64_t BoneMask, const FQuat4f* Rotations,
+    double DisplayTime_, const FTsMocapPredictionSettings& Prediction_)
+{
+    // Anim node keeps component space location of the bone and replaces its rotation
+    TArray<TPair<Target*, FTransform>> Poses;
+    const FTransform& ParentToWorld = Mesh.GetComponentTransform();
+    for (auto& Item : Targets)
+    {
+        const int32 MeshBone = Mesh.GetBoneIndex(Item->MeshBone);
+        const bool bValid = Item->Component.IsValid() && MeshBone != INDEX_NONE && (BoneMask & (1ull << Item->Bone)) != 0;
+        Item->LateUpdate.Setup(ParentToWorld, Item->Component.Get(), !bValid);
+        if (bValid)
+        {
+            const FVector Location = Mesh.GetBoneTransform(MeshBone, FTransform::Identity).GetLocation();
+            Poses.Emplace(Item.Get(), FTransform(FQuat(Rotations[Item->Bone]) * Item->Offset, Location));
+        }
+    }
+
+    ENQUEUE_RENDER_COMMAND(TsMocapLateUpdateSetup)([this, Poses = MoveTemp(Poses), DisplayTime_, Prediction_](FRHICommandListImmediate& RHICmdList)
+    {
+        Prediction = Prediction_;
+        DisplayTime = DisplayTime_;
+        for (auto& Item : Targets)
+        {
+            Item->bRenderThreadValid = false;
+        }
+        for (const auto& Pose : Poses)
+        {
+            Pose.Key->RenderThreadPose = Pose.Value;
+            Pose.Key->bRenderThreadValid = true;
+        }
+    });
+}
+
+void FTsMocapLateUpdate::PreRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily)
+{
+    SCOPE_CYCLE_COUNTER(STAT_TsMocapLateUpdate);
+    if (Targets.Num() == 0 || InViewFamily.Scene == nullptr)
+    {
+        return;
+    }
+
+    // Copy newest bones of targets, frame is read in place
+    Reader->SkipToLatest();
+    auto Frame = Reader->BeginRead();
+    if (Frame == nullptr)
+    {
+        return;
+    }
+    alignas(16) FQuat4f Rotations[TsMocapFrame::BonesCount];
+    alignas(16) FVector4f Translations[TsMocapFrame::BonesCount];
+    // Display time doesn't move with the render thread, newer frame is predicted only for the time remaining until it
+    TsMocapPredictor::Predict(*Frame, DisplayTime, Prediction, Rotations, Translations);
+
+    TArray<FTransform, TInlineAllocator<8>> Latest;
+    for (const auto& Item : Targets)
+    {
+        Latest.Add(Frame->HasBone(Item->Bone) ?
+            FTransform(FQuat(Rotations[Item->Bone]) * Item->Offset, Item->RenderThreadPose.GetLocation()) : Item->RenderThreadPose);
+    }
+    if (!Reader->EndRead())
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < Targets.Num(); ++Index)
+    {
+        auto& Item = *Targets[Index];
+        if (Item.bRenderThreadValid && !Item.LateUpdate.GetSkipLateUpdate_RenderThread())
+        {
+            Item.LateUpdate.Apply_RenderThread(InViewFamily.Scene, Item.RenderThreadPose, Latest[Index]);
+        }
+    }
+}
+
+bool FTsMocapLateUpdate::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+    return Targets.Num() > 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <memory>
+#include "CoreMinimal.h"
+#include "LateUpdateManager.h"
+#include "SceneViewExtension.h"
+#include "Motion/TsMocapFrameBus.h"
+#include "Motion/TsMocapPrediction.h"
+
+class USceneComponent;
+class USkeletalMeshComponent;
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Late update of components attached to mocap bones.
+
+    Works like motion controller late update: right before the view family is rendered,
+    the newest mocap frame is read on the render thread and the difference between it and
+    the pose used by the game thread is applied to primitives of registered components.
+    Bone transforms are built like the anim node builds them: component space location of the mesh bone
+    and mocap rotation multiplied by the node offset, relative to the skeletal mesh component.
+*/
+class FTsMocapLateUpdate : public FSceneViewExtensionBase
+{
+public:
+    FTsMocapLateUpdate(const FAutoRegister& AutoRegister, std::unique_ptr<TsMocapFrameBus::Reader> Reader_);
+
+    /*!
+        \brief Registers component to follow the mesh bone driven by the mocap bone, game thread only.
+    */
+    void AddTarget(USceneComponent* Component, int32 Bone, FName MeshBone, const FQuat& Offset);
+
+    /*!
+        \brief Unregisters component, game thread only.
+    */
+    void RemoveTarget(USceneComponent* Component);
+
+    /*!
+        \brief Captures targets and the pose applied by the game thread this frame.
+
+        Newest pose is extrapolated on render thread with the same prediction settings,
+        up to the display time the game thread pose was predicted for.
+    */
+    void Update_GameThread(const USkeletalMeshComponent& Mesh, std::uint64_t BoneMask, const FQuat4f* Rotations,
+        double DisplayTime_, const FTsMocapPredictionSettings& Prediction_);
+
+    // ISceneViewExtension
+    virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+    virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+    virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+    virtual void PreRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily) override;
+
+protected:
+    virtual bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
+
+private:
+    struct Target
+    {
+        TWeakObjectPtr<USceneComponent> Component;
+        int32 Bone = 0;
+        FName MeshBone;
+        FQuat Offset = FQuat::Identity;
+        FLateUpdateManager LateUpdate;
+        FTransform RenderThreadPose;
+        bool bRenderThreadValid = false;
+    };
+
+    TArray<TUniquePtr<Target>> Targets;
+    FTsMocapPredictionSettings Prediction;
+    double DisplayTime = 0.0;
+    std::unique_ptr<TsMocapFrameBus::Reader> Reader;
+};
+
+/**@}*/
@@ -0,0 +1,125 @@
+#include "Motion/TsMocapLatency.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "TsStats.h"
+#include "Utils/TsHistogram.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Transport (ms)"), STAT_TsMocapLatencyTransport, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Processing (ms)"), STAT_TsMocapLatencyProcessing, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Pickup (ms)"), STAT_TsMocapLatencyPickup, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Animation (ms)"), STAT_TsMocapLatencyAnimation, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Render (ms)"), STAT_TsMocapLatencyRender, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Latency Total (ms)"), STAT_TsMocapLatencyTotal, STATGROUP_Teslasuit);
+
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyTransport, TEXT("Teslasuit/Mocap/Latency/Transport"));
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyProcessing, TEXT("Teslasuit/Mocap/Latency/Processing"));
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyPickup, TEXT("Teslasuit/Mocap/Latency/Pickup"));
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyAnimation, TEXT("Teslasuit/Mocap/Latency/Animation"));
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyRender, TEXT("Teslasuit/Mocap/Latency/Render"));
+TRACE_DECLARE_FLOAT_COUNTER(TsMocapLatencyTotal, TEXT("Teslasuit/Mocap/Latency/Total"));
+
+static TAutoConsoleVariable<float> CVarTsMocapDeviceTimestampScale(
+    TEXT("Teslasuit.Mocap.DeviceTimestampScale"),
+    1.0e-6f,
+    TEXT("Seconds per tick of mocap sensor timestamps."),
+    ECVF_Default);
+
+namespace
+{
+    using LatencyHistogram = TsHistogram<200>;
+    const std::size_t StagesCount = static_cast<std::size_t>(TsMocapLatency::EStage::Count);
+    const TCHAR* StageNames[StagesCount] = { TEXT("Transport"), TEXT("Processing"), TEXT("Pickup"), TEXT("Animation"), TEXT("Render"), TEXT("Total") };
+
+    // Drift allowance of device clock offset per second
+    const double OffsetRelaxRate = 1.0e-4;
+
+    LatencyHistogram* GetHistograms()
+    {
+        // 0.25 ms buckets up to 50 ms
+        static LatencyHistogram Histograms[StagesCount] = {
+            LatencyHistogram(0.25), LatencyHistogram(0.25), LatencyHistogram(0.25),
+            LatencyHistogram(0.25), LatencyHistogram(0.25), LatencyHistogram(0.25) };
+        return Histograms;
+    }
+
+    void PrintReport()
+    {
+        const auto Histograms = GetHistograms();
+        for (std::size_t Stage = 0; Stage < StagesCount; ++Stage)
+        {
+            const auto& Histogram = Histograms[Stage];
+            UE_LOG(LogTemp, Display, TEXT("TsMocapLatency: %-10s samples %llu, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms."),
+                StageNames[Stage], Histogram.GetCount(), Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9),
+                Histogram.GetPercentile(0.99), Histogram.GetMax());
+        }
+    }
+
+    void ResetReport()
+    {
+        const auto Histograms = GetHistograms();
+        for (std::size_t Stage = 0; Stage < StagesCount; ++Stage)
+        {
+            Histograms[Stage].Reset();
+        }
+    }
+}
+
+static FAutoConsoleCommand TsMocapLatencyReportCommand(
+    TEXT("Teslasuit.Mocap.LatencyReport"),
+    TEXT("Prints mocap latency percentiles per pipeline stage."),
+    FConsoleCommandDelegate::CreateStatic(&PrintReport));
+
+static FAutoConsoleCommand TsMocapLatencyResetCommand(
+    TEXT("Teslasuit.Mocap.LatencyReset"),
+    TEXT("Clears collected mocap latency histograms."),
+    FConsoleCommandDelegate::CreateStatic(&ResetReport));
+
+void TsMocapLatency::Record(EStage Stage, double Seconds)
+{
+    if (Stage >= EStage::Count)
+    {
+        return;
+    }
+    const double Milliseconds = Seconds * 1000.0;
+    GetHistograms()[static_cast<std::size_t>(Stage)].Add(Milliseconds);
+
+    switch (Stage)
+    {
+    case EStage::Transport:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyTransport, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyTransport, Milliseconds);
+        break;
+    case EStage::Processing:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyProcessing, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyProcessing, Milliseconds);
+        break;
+    case EStage::Pickup:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyPickup, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyPickup, Milliseconds);
+        break;
+    case EStage::Animation:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyAnimation, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyAnimation, Milliseconds);
+        break;
+    case EStage::Render:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyRender, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyRender, Milliseconds);
+        break;
+    default:
+        SET_FLOAT_STAT(STAT_TsMocapLatencyTotal, Milliseconds);
+        TRACE_COUNTER_SET(TsMocapLatencyTotal, Milliseconds);
+        break;
+    }
+}
+
+double TsMocapLatency::DeviceClock::ToPlatformTime(std::uint64_t DeviceTimestamp, double ArrivalTime)
+{
+    const double DeviceTime = DeviceTimestamp * static_cast<double>(CVarTsMocapDeviceTimestampScale.GetValueOnAnyThread());
+    const double Delay = ArrivalTime - DeviceTime;
+
+    // Fastest delivery defines the offset, let it rise slowly in case device clock drifts
+    Offset = bValid ? FMath::Min(Offset + OffsetRelaxRate * (ArrivalTime - LastArrivalTime), Delay) : Delay;
+    LastArrivalTime = ArrivalTime;
+    bValid = true;
+    return DeviceTime + Offset;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include "CoreMinimal.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Latency tracking of mocap poses from sensor to rendered frame.
+
+    Each stage is measured from the previous stamp of the same pose and collected
+    into a histogram, last values are shown with "stat Teslasuit" and as Insights counters,
+    percentiles are printed with "Teslasuit.Mocap.LatencyReport" console command.
+*/
+namespace TsMocapLatency
+{
+    enum class EStage : uint8
+    {
+        /*! Device capture to callback arrival, relative to the fastest observed delivery. */
+        Transport = 0,
+        /*! Callback arrival to frame published by stream worker. */
+        Processing,
+        /*! Frame published to picked up by consumer. */
+        Pickup,
+        /*! Pickup to animation update. */
+        Animation,
+        /*! Animation update to render thread. */
+        Render,
+        /*! Device capture, or callback arrival if unknown, to render thread. */
+        Total,
+        Count
+    };
+
+    /*!
+        \brief Records stage latency in seconds, can be called from any thread.
+    */
+    void Record(EStage Stage, double Seconds);
+
+    /*!
+        \brief Maps device timestamp to platform time, called by stream worker.
+
+        Device and host clocks are not synchronized, offset between them is tracked
+        as the minimal observed delivery delay, slowly relaxed to follow clock drift.
+    */
+    class DeviceClock
+    {
+    public:
+        double ToPlatformTime(std::uint64_t DeviceTimestamp, double ArrivalTime);
+        void Reset() { bValid = false; }
+
+    private:
+        double Offset = 0.0;
+        double LastArrivalTime = 0.0;
+        bool bValid = false;
+    };
+}
+
+/**@}*/
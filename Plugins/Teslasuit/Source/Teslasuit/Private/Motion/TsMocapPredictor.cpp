@@ -0,0 +1,106 @@
+#include "Motion/TsMocapPredictor.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    void CopyPose(const TsMocapFrame& Frame, FQuat4f* OutRotations, FVector4f* OutTranslations)
+    {
+        for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            const auto Bone = FMath::CountTrailingZeros64(Bits);
+            OutRotations[Bone] = Frame.Rotations[Bone];
+            OutTranslations[Bone] = Frame.Translations[Bone];
+        }
+    }
+}
+
+void TsMocapPredictor::Predict(const TsMocapFrame& Frame, double TargetTime, const FTsMocapPredictionSettings& Settings,
+    FQuat4f* OutRotations, FVector4f* OutTranslations)
+{
+    CopyPose(Frame, OutRotations, OutTranslations);
+
+    // Fall back to captured pose when sensors are stale
+    const double SampleTime = Frame.DeviceTime > 0.0 ? Frame.DeviceTime : Frame.CaptureTime;
+    const std::uint64_t Mask = Frame.BoneMask & Frame.SensorMask;
+    if (!Settings.bEnabled || Mask == 0 || Frame.CaptureTime - Frame.SensorTime > Settings.MaxSensorAgeMs * 0.001)
+    {
+        return;
+    }
+    const float Horizon = static_cast<float>(FMath::Clamp(TargetTime - SampleTime, 0.0, Settings.MaxHorizonMs * 0.001));
+    if (Horizon <= 0.0f)
+    {
+        return;
+    }
+
+    // Velocity decays exponentially over the horizon, integrate it in closed form
+    const float Damping = Settings.Damping;
+    const float Effective = Damping > KINDA_SMALL_NUMBER ? (1.0f - FMath::Exp(-Damping * Horizon)) / Damping : Horizon;
+
+    int32 Bones[TsMocapFrame::BonesCount];
+    int32 BonesCount = 0;
+    for (auto Bits = Mask; Bits != 0; Bits &= Bits - 1)
+    {
+        Bones[BonesCount++] = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+    }
+
+    const VectorRegister4Float HalfEffectiveTime = VectorSetFloat1(Effective * 0.5f);
+    const VectorRegister4Float MaxSpeed = VectorSetFloat1(FMath::DegreesToRadians(Settings.MaxAngularSpeed));
+    const VectorRegister4Float MinSpeed = VectorSetFloat1(KINDA_SMALL_NUMBER);
+    const VectorRegister4Float VelocityTime = VectorSetFloat1(Effective);
+    const VectorRegister4Float AccelerationTime = VectorSetFloat1(0.5f * Effective * Effective);
+
+    // Four bones per pass: rotation angles and their sines are computed across bones
+    for (int32 First = 0; First < BonesCount; First += 4)
+    {
+        alignas(16) float X[4] = {}, Y[4] = {}, Z[4] = {};
+        const int32 Count = FMath::Min(4, BonesCount - First);
+        for (int32 Lane = 0; Lane < Count; ++Lane)
+        {
+            const auto& Velocity = Frame.AngularVelocities[Bones[First + Lane]];
+            X[Lane] = Velocity.X;
+            Y[Lane] = Velocity.Y;
+            Z[Lane] = Velocity.Z;
+        }
+        const VectorRegister4Float VX = VectorLoadAligned(X);
+        const VectorRegister4Float VY = VectorLoadAligned(Y);
+        const VectorRegister4Float VZ = VectorLoadAligned(Z);
+
+        const VectorRegister4Float Speed = VectorSqrt(VectorMultiplyAdd(VX, VX, VectorMultiplyAdd(VY, VY, VectorMultiply(VZ, VZ))));
+        VectorRegister4Float Sin, Cos;
+        const VectorRegister4Float HalfAngle = VectorMultiply(Speed, HalfEffectiveTime);
+        VectorSinCos(&Sin, &Cos, &HalfAngle);
+
+        // Implausible speed means unreliable reading, keep identity delta
+        const VectorRegister4Float Reliable = VectorCompareLE(Speed, MaxSpeed);
+        const VectorRegister4Float AxisScale = VectorSelect(Reliable, VectorDivide(Sin, VectorMax(Speed, MinSpeed)), VectorZeroFloat());
+        const VectorRegister4Float DeltaW = VectorSelect(Reliable, Cos, VectorOneFloat());
+
+        alignas(16) float DX[4], DY[4], DZ[4], DW[4];
+        VectorStoreAligned(VectorMultiply(VX, AxisScale), DX);
+        VectorStoreAligned(VectorMultiply(VY, AxisScale), DY);
+        VectorStoreAligned(VectorMultiply(VZ, AxisScale), DZ);
+        VectorStoreAligned(DeltaW, DW);
+
+        for (int32 Lane = 0; Lane < Count; ++Lane)
+        {
+            const int32 Bone = Bones[First + Lane];
+
+            // Angular velocity is expressed in local space of the offset rotation, so the delta applies on the right
+            // and equals rotating the sensor before its offset
+            const VectorRegister4Float Rotation = VectorLoadAligned(&Frame.Rotations[Bone].X);
+            const VectorRegister4Float Delta = MakeVectorRegisterFloat(DX[Lane], DY[Lane], DZ[Lane], DW[Lane]);
+            const VectorRegister4Float Predicted = VectorNormalizeQuaternion(VectorQuaternionMultiply2(Rotation, Delta));
+            VectorStoreAligned(Predicted, &OutRotations[Bone].X);
+
+            if (Settings.bUseAcceleration)
+            {
+                // Displacement is v * t + a * t^2 / 2, acceleration is rotated from bone local space
+                const VectorRegister4Float Velocity = VectorLoadAligned(&Frame.LinearVelocities[Bone].X);
+                const VectorRegister4Float Acceleration = VectorLoadAligned(&Frame.Accelerations[Bone].X);
+                const VectorRegister4Float Offset = VectorMultiplyAdd(Velocity, VelocityTime,
+                    VectorQuaternionRotateVector(Rotation, VectorMultiply(Acceleration, AccelerationTime)));
+                VectorStoreAligned(VectorAdd(VectorLoadAligned(&Frame.Translations[Bone].X), VectorSet_W0(Offset)), &OutTranslations[Bone].X);
+            }
+        }
+    }
+}
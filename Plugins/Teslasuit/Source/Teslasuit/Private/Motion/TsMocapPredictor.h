@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Motion/TsMocapFrame.h"
+#include "Motion/TsMocapPrediction.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Short horizon extrapolation of mocap poses.
+
+    Bone rotations are integrated with sensor angular velocity, damped over the horizon,
+    optionally translations are integrated with velocity estimated from consecutive poses
+    and sensor linear acceleration. Bones without fresh
+    or plausible sensor data keep their captured pose.
+*/
+namespace TsMocapPredictor
+{
+    /*!
+        \brief Writes bones of the frame extrapolated to TargetTime (platform time) to output streams.
+
+        Output streams are indexed by bone, only bones of the frame are written.
+    */
+    void Predict(const TsMocapFrame& Frame, double TargetTime, const FTsMocapPredictionSettings& Settings,
+        FQuat4f* OutRotations, FVector4f* OutTranslations);
+}
+
+/**@}*/
@@ -0,0 +1,52 @@
+#include "Motion/TsMocapRecorder.h"
+#include "Utils/TsStreamWorker.h"
+
+namespace
+{
+    // Frame bus holds several frames, polling well within it keeps the capture dense
+    const uint32 CapturePeriodMs = 5;
+}
+
+TsMocapRecorder::TsMocapRecorder(std::unique_ptr<TsMocapFrameBus::Reader> Reader_)
+    : Reader(std::move(Reader_))
+{
+    Worker = std::make_unique<TsStreamWorker>(TEXT("TsMocapRecorder"), [this]() { Capture(); }, CapturePeriodMs);
+}
+
+TsMocapRecorder::~TsMocapRecorder()
+{
+    Worker.reset();
+}
+
+TsMocapRecording TsMocapRecorder::Stop()
+{
+    // Frames published after the last poll are still in the bus
+    Worker.reset();
+    Capture();
+    return std::move(Recording);
+}
+
+void TsMocapRecorder::Capture()
+{
+    while (auto Frame = Reader->BeginRead())
+    {
+        const auto Offset = Recording.Rotations.size();
+        for (auto Bits = Frame->BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            Recording.Rotations.push_back(Frame->Rotations[FMath::CountTrailingZeros64(Bits)]);
+        }
+        const double Time = Frame->DeviceTime > 0.0 ? Frame->DeviceTime : Frame->CaptureTime;
+        const auto Mask = Frame->BoneMask;
+
+        // Overwritten frame is dropped, it is interpolated over when baking
+        if (!Reader->EndRead())
+        {
+            Recording.Rotations.resize(Offset);
+            continue;
+        }
+        Recording.Times.push_back(Recording.Times.empty() ? Time : FMath::Max(Time, Recording.Times.back()));
+        Recording.Masks.push_back(Mask);
+        Recording.Offsets.push_back(static_cast<std::uint32_t>(Offset));
+        FramesCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "Motion/TsMocapFrameBus.h"
+
+class TsStreamWorker;
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Dense mocap rotations captured by #TsMocapRecorder.
+
+    Bones of each frame are packed in bone order starting at the frame offset.
+*/
+struct TsMocapRecording
+{
+    std::vector<double> Times;
+    std::vector<std::uint64_t> Masks;
+    std::vector<std::uint32_t> Offsets;
+    std::vector<FQuat4f> Rotations;
+
+    std::size_t Num() const { return Times.size(); }
+};
+
+/*!
+    \brief Captures every frame of mocap stream on its own thread.
+
+    Recorder reads frame bus like any other consumer, so capture doesn't add work
+    to the game thread nor to the stream worker.
+*/
+class TsMocapRecorder
+{
+public:
+    explicit TsMocapRecorder(std::unique_ptr<TsMocapFrameBus::Reader> Reader_);
+    ~TsMocapRecorder();
+
+    /*!
+        \brief Stops capture and returns captured frames.
+    */
+    TsMocapRecording Stop();
+
+    /*!
+        \brief Number of frames captured so far, can be called from any thread.
+    */
+    std::uint64_t GetFramesCount() const { return FramesCount.load(std::memory_order_relaxed); }
+
+private:
+    void Capture();
+
+private:
+    std::unique_ptr<TsMocapFrameBus::Reader> Reader;
+    TsMocapRecording Recording;
+    std::atomic<std::uint64_t> FramesCount{ 0 };
+    std::unique_ptr<TsStreamWorker> Worker;
+};
+
+/**@}*/
@@ -1,8 +1,67 @@
 #include "Motion/TsMotion.h"
+#include "Motion/TsMocapLatency.h"
+#include "Motion/TsMocapLateUpdate.h"
+#include "Motion/TsMocapPredictor.h"
+#include "Motion/TsMocapRecorder.h"
+#include "Motion/TsMocapBaker.h"
+#include "Motion/SkeletonBoneTransform.h"
+#include "Animation/AnimClassInterface.h"
+#include "RenderingThread.h"
+#include "TsStats.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
+#include "Runtime/Engine/Classes/GameFramework/PlayerController.h"
+#include "Runtime/Engine/Classes/Camera/PlayerCameraManager.h"
 #include "Runtime/UMG/Public/Components/WidgetComponent.h"
 #include "Runtime/UMG/Public/Blueprint/UserWidget.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Lod Full"), STAT_TsMotionLodFull, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Lod No Fingers"), STAT_TsMotionLodNoFingers, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Lod Reduced"), STAT_TsMotionLodReduced, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Lod Frozen"), STAT_TsMotionLodFrozen, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Poses Applied"), STAT_TsMotionPosesApplied, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Motion Poses Idle"), STAT_TsMotionPosesIdle, STATGROUP_Teslasuit);
+
+namespace
+{
+	const std::uint64_t AllBonesMask = (1ull << static_cast<int32>(FTsBoneIndex::TsBoneIndex_BonesCount)) - 1;
+
+	// Hips to hands, fingers follow in bone order
+	const std::uint64_t BodyBonesMask = (1ull << static_cast<int32>(FTsBoneIndex::TsBoneIndex_LeftThumbProximal)) - 1;
+
+	// Bones driven by Teslasuit anim nodes of the animation, with their offsets
+	TArray<TsMocapBaker::BoneMapping> GetDrivenBones(UTsMotionAnimation* Animation)
+	{
+		TArray<TsMocapBaker::BoneMapping> Bones;
+		const IAnimClassInterface* AnimClass = Animation != nullptr ? IAnimClassInterface::GetFromClass(Animation->GetClass()) : nullptr;
+		if (AnimClass == nullptr)
+		{
+			return Bones;
+		}
+		for (const FStructProperty* Property : AnimClass->GetAnimNodeProperties())
+		{
+			if (!Property->Struct->IsChildOf(FAnimNode_SkeletalBoneTransform::StaticStruct()))
+			{
+				continue;
+			}
+			const auto Node = Property->ContainerPtrToValuePtr<FAnimNode_SkeletalBoneTransform>(Animation);
+			if (Node->Profile != nullptr)
+			{
+				for (const auto& It : Node->Profile->Bones)
+				{
+					Bones.Add({ It.Value.BoneName, static_cast<int32>(It.Key), It.Value.Offset.Quaternion() });
+				}
+				continue;
+			}
+			for (const auto& Pair : Node->BonesToModify)
+			{
+				const auto Offset = Node->RotationOffsets.Find(Pair.BoneIndex);
+				Bones.Add({ Pair.BoneRef.BoneName, static_cast<int32>(Pair.BoneIndex), Offset != nullptr ? *Offset : FQuat::Identity });
+			}
+		}
+		return Bones;
+	}
+}
+
 UTsMotion::UTsMotion()
 	: UActorComponent()
 {
@@ -32,6 +91,16 @@ void UTsMotion::SetSkeletalMesh(USkeletalMeshComponent* skeletalMesh)
 		SkeletalMesh->SetAnimInstanceClass(AnimationClass);
 		SkeletalMesh->InitAnim(true);
 	}
+
+	// Mesh assigned at runtime gets the same tick settings as the one found on begin play
+	if (Lod.bEnabled)
+	{
+		SkeletalMesh->bEnableUpdateRateOptimizations |= Lod.bUseUpdateRateOptimizations;
+		if (Lod.bFreezeWhenNotRendered)
+		{
+			SkeletalMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+		}
+	}
 }
 
 void UTsMotion::BeginPlay()
@@ -39,12 +108,185 @@ void UTsMotion::BeginPlay()
     Super::BeginPlay();
 
 	mocap = NewObject<UTsMocap>();
+	mocap->SetFilterSettings(FilterSettings);
 
 	SetSkeletalMesh(nullptr);
 }
 
+ETsMotionLod UTsMotion::GetLod() const
+{
+	return CurrentLod;
+}
+
+ETsMotionLod UTsMotion::SelectLod() const
+{
+	if (!Lod.bEnabled || SkeletalMesh == nullptr)
+	{
+		return ETsMotionLod::Full;
+	}
+
+	const bool bRendered = SkeletalMesh->WasRecentlyRendered(Lod.NotRenderedTime);
+	if (!bRendered && Lod.bFreezeWhenNotRendered)
+	{
+		return ETsMotionLod::Frozen;
+	}
+	if (!bRendered && Lod.bReduceWhenNotRendered)
+	{
+		return ETsMotionLod::Reduced;
+	}
+
+	// Distance to the nearest local view, split screen included
+	const FVector Location = SkeletalMesh->GetComponentLocation();
+	double DistanceSquared = TNumericLimits<double>::Max();
+	for (auto It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (Controller != nullptr && Controller->IsLocalController() && Controller->PlayerCameraManager != nullptr)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Location, Controller->PlayerCameraManager->GetCameraLocation()));
+		}
+	}
+	if (DistanceSquared > FMath::Square(static_cast<double>(Lod.ReducedRateDistance)))
+	{
+		return ETsMotionLod::Reduced;
+	}
+	if (DistanceSquared > FMath::Square(static_cast<double>(Lod.FingerCullDistance)))
+	{
+		return ETsMotionLod::NoFingers;
+	}
+	return ETsMotionLod::Full;
+}
+
 void UTsMotion::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	StopCapture();
+	if (mocap != nullptr)
+	{
+		mocap->SetRequiredBones(this, 0);
+		SubscribedBones = 0;
+	}
+	if (LateUpdate.IsValid())
+	{
+		// Render commands hold the extension until they are executed
+		FlushRenderingCommands();
+		LateUpdate.Reset();
+	}
+	SetPoseIdle(false);
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTsMotion::StartCapture()
+{
+	if (mocap == nullptr || MotionAnimation == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UTsMotion: failed to start capture - motion is not initialized."));
+		return;
+	}
+	if (Recorder != nullptr)
+	{
+		return;
+	}
+	const auto Bones = GetDrivenBones(MotionAnimation);
+	if (Bones.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UTsMotion: failed to start capture - animation has no mapped bones."));
+		return;
+	}
+
+	// Capture keeps mapped bones streaming whatever detail level the character has
+	std::uint64_t Mask = 0;
+	for (const auto& Bone : Bones)
+	{
+		Mask |= 1ull << Bone.MocapBone;
+	}
+	Recorder = std::make_shared<TsMocapRecorder>(mocap->CreateFrameReader());
+	mocap->SetRequiredBones(Recorder.get(), Mask);
+}
+
+void UTsMotion::StopCapture()
+{
+	if (Recorder == nullptr)
+	{
+		return;
+	}
+	if (mocap != nullptr)
+	{
+		mocap->SetRequiredBones(Recorder.get(), 0);
+	}
+	auto Recording = Recorder->Stop();
+	Recorder.reset();
+
+	USkeleton* Skeleton = CaptureSettings.TargetSkeleton;
+	if (Skeleton == nullptr && SkeletalMesh != nullptr && SkeletalMesh->GetSkeletalMeshAsset() != nullptr)
+	{
+		Skeleton = SkeletalMesh->GetSkeletalMeshAsset()->GetSkeleton();
+	}
+	TsMocapBaker::BakeAsync(MoveTemp(Recording), GetDrivenBones(MotionAnimation), Skeleton, CaptureSettings,
+		[WeakThis = TWeakObjectPtr<UTsMotion>(this)](UAnimSequence* Sequence)
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->OnCaptureBaked.Broadcast(Sequence);
+		}
+	});
+}
+
+bool UTsMotion::IsCapturing() const
+{
+	return Recorder != nullptr;
+}
+
+void UTsMotion::SetPoseIdle(bool bIdle)
+{
+	if (MotionAnimation != nullptr)
+	{
+		MotionAnimation->bPoseIdle = bIdle;
+	}
+	if (SkeletalMesh != nullptr && bSkipIdleEvaluation)
+	{
+		SkeletalMesh->bNoSkeletonUpdate = bIdle;
+	}
+}
+
+void UTsMotion::AddLateUpdateComponent(USceneComponent* Component, FTsBoneIndex Bone)
+{
+	if (Component == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UTsMotion: failed to add late update component - null component."));
+		return;
+	}
+	RemoveLateUpdateComponent(Component);
+	LateUpdateComponents.Emplace(Component, Bone);
+	if (LateUpdate.IsValid())
+	{
+		AddLateUpdateTarget(Component, Bone);
+	}
+}
+
+void UTsMotion::AddLateUpdateTarget(USceneComponent* Component, FTsBoneIndex Bone)
+{
+	// Component follows the mesh bone driven by the anim node, with the same offset
+	for (const auto& Mapping : GetDrivenBones(MotionAnimation))
+	{
+		if (Mapping.MocapBone == static_cast<int32>(Bone))
+		{
+			LateUpdate->AddTarget(Component, Mapping.MocapBone, Mapping.Bone, Mapping.Offset);
+			return;
+		}
+	}
+	UE_LOG(LogTemp, Error, TEXT("UTsMotion: failed to add late update component - bone is not driven by the animation."));
+}
+
+void UTsMotion::RemoveLateUpdateComponent(USceneComponent* Component)
+{
+	LateUpdateComponents.RemoveAll([Component](const TPair<TWeakObjectPtr<USceneComponent>, FTsBoneIndex>& Item)
+	{
+		return Item.Key.Get() == Component;
+	});
+	if (LateUpdate.IsValid())
+	{
+		LateUpdate->RemoveTarget(Component);
+	}
 }
 
 void UTsMotion::UninitializeComponent()
@@ -52,6 +294,19 @@ void UTsMotion::UninitializeComponent()
 
 }
 
+void UTsMotion::UpdateLateUpdate(std::uint64_t BoneMask, const FQuat4f* Rotations, double DisplayTime)
+{
+	if (!LateUpdate.IsValid())
+	{
+		LateUpdate = FSceneViewExtensions::NewExtension<FTsMocapLateUpdate>(mocap->CreateFrameReader());
+		for (const auto& Item : LateUpdateComponents)
+		{
+			AddLateUpdateTarget(Item.Key.Get(), Item.Value);
+		}
+	}
+	LateUpdate->Update_GameThread(*SkeletalMesh, BoneMask, Rotations, DisplayTime, Prediction);
+}
+
 void UTsMotion::TickComponent
 (
 	float DeltaTime,
@@ -63,7 +318,110 @@ void UTsMotion::TickComponent
 	{
 		if (mocap->DeviceInitialized)
 		{
-			mocap->GetMocapData(MotionAnimation->data);
+			// Readers belong to the stream of current device
+			if (FrameReader == nullptr || ReaderBus != mocap->GetFrameBus())
+			{
+				FrameReader = mocap->CreateFrameReader();
+				ReaderBus = mocap->GetFrameBus();
+				AppliedPoseVersion = 0;
+				MotionAnimation->ResetPose();
+				if (LateUpdate.IsValid())
+				{
+					FlushRenderingCommands();
+					LateUpdate.Reset();
+				}
+			}
+
+			CurrentLod = SelectLod();
+			switch (CurrentLod)
+			{
+			case ETsMotionLod::Full: INC_DWORD_STAT(STAT_TsMotionLodFull); break;
+			case ETsMotionLod::NoFingers: INC_DWORD_STAT(STAT_TsMotionLodNoFingers); break;
+			case ETsMotionLod::Reduced: INC_DWORD_STAT(STAT_TsMotionLodReduced); break;
+			case ETsMotionLod::Frozen: INC_DWORD_STAT(STAT_TsMotionLodFrozen); break;
+			}
+			const std::uint64_t LodMask = CurrentLod == ETsMotionLod::Full ? AllBonesMask : BodyBonesMask;
+			MotionAnimation->SetEvaluatedBones(LodMask);
+
+			// Stream only bones consumed by anim graph at current detail and late update, unknown consumption needs all bones,
+			// empty mask removes the consumer and is only registered on end play
+			std::uint64_t Required = MotionAnimation->GetRequiredBones();
+			Required = (Required != 0 ? Required : AllBonesMask) & LodMask;
+			for (const auto& Item : LateUpdateComponents)
+			{
+				Required |= 1ull << static_cast<int32>(Item.Value);
+			}
+			if (Required != SubscribedBones)
+			{
+				mocap->SetRequiredBones(this, Required);
+				SubscribedBones = Required;
+			}
+
+			// Frozen characters keep their pose, reduced ones pick up poses at lower rate
+			const double Now = FPlatformTime::Seconds();
+			const bool bSkipPose = CurrentLod == ETsMotionLod::Frozen ||
+				(CurrentLod == ETsMotionLod::Reduced && Now - LastPoseTime < 1.0 / FMath::Max(Lod.ReducedRateHz, 1.0f));
+
+			// Animation needs only the latest pose, copy it out and commit once the read is known to be consistent
+			FrameReader->SkipToLatest();
+			if (auto Frame = bSkipPose ? nullptr : FrameReader->BeginRead())
+			{
+				const double PickupTime = Now;
+				const double PublishTime = Frame->PublishTime;
+				const double OriginTime = Frame->DeviceTime > 0.0 ? Frame->DeviceTime : Frame->CaptureTime;
+				const std::uint64_t PoseVersion = Frame->PoseVersion;
+				const std::uint64_t BoneMask = Frame->BoneMask;
+				const bool bIdle = PoseVersion == AppliedPoseVersion && BoneMask == AppliedBoneMask;
+				const double DisplayTime = PickupTime + Prediction.LeadTimeMs * 0.001;
+
+				// Pose is extrapolated to display time if prediction is enabled, copied otherwise
+				alignas(16) FQuat4f Rotations[TsMocapFrame::BonesCount];
+				alignas(16) FVector4f Translations[TsMocapFrame::BonesCount];
+				if (bIdle)
+				{
+					FMemory::Memcpy(Rotations, Frame->Rotations, sizeof(Rotations));
+				}
+				else
+				{
+					TsMocapPredictor::Predict(*Frame, DisplayTime, Prediction, Rotations, Translations);
+				}
+				if (!FrameReader->EndRead())
+				{
+					return;
+				}
+
+				LastPoseTime = Now;
+				TsMocapLatency::Record(TsMocapLatency::EStage::Pickup, PickupTime - PublishTime);
+				MotionAnimation->SetPoseTimes(OriginTime, PickupTime);
+
+				// Unchanged pose is already in data, bone-attached components still follow the actor
+				SetPoseIdle(bIdle);
+				if (bIdle)
+				{
+					INC_DWORD_STAT(STAT_TsMotionPosesIdle);
+					if (bLateUpdate && SkeletalMesh != nullptr)
+					{
+						UpdateLateUpdate(BoneMask, Rotations, DisplayTime);
+					}
+					return;
+				}
+				AppliedPoseVersion = PoseVersion;
+				AppliedBoneMask = BoneMask;
+				INC_DWORD_STAT(STAT_TsMotionPosesApplied);
+
+				auto& Data = MotionAnimation->data;
+				for (auto Bits = BoneMask; Bits != 0; Bits &= Bits - 1)
+				{
+					const auto Index = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+					const auto& T = Translations[Index];
+					Data.FindOrAdd(static_cast<FTsBoneIndex>(Index)) = FTransform(FQuat(Rotations[Index]), FVector(T.X, T.Y, T.Z));
+				}
+				MotionAnimation->SetPoseRotations(BoneMask, Rotations);
+				if (bLateUpdate && SkeletalMesh != nullptr)
+				{
+					UpdateLateUpdate(BoneMask, Rotations, DisplayTime);
+				}
+			}
 		}
 	}
 	else
@@ -1,4 +1,6 @@
 #include "Motion/TsMotionAnimation.h"
+#include "RenderingThread.h"
+#include "Motion/TsMocapLatency.h"
 
 UTsMotionAnimation::UTsMotionAnimation(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -13,4 +15,74 @@ void UTsMotionAnimation::NativeInitializeAnimation()
 void UTsMotionAnimation::NativeUpdateAnimation(float DeltaTimeX)
 {
     Super::NativeUpdateAnimation(DeltaTimeX);
+
+    // Update runs on game thread after previous evaluation has finished, so anim nodes read a stable copy
+    for (auto Bits = PendingPoseMask; Bits != 0; Bits &= Bits - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Bits);
+        PoseRotations[Index] = PendingPoseRotations[Index];
+    }
+    PoseMask = PendingPoseMask;
+
+    // Track each pose once, from animation update until render thread picks up the frame
+    if (PosePickupTime > 0.0)
+    {
+        const double UpdateTime = FPlatformTime::Seconds();
+        TsMocapLatency::Record(TsMocapLatency::EStage::Animation, UpdateTime - PosePickupTime);
+        ENQUEUE_RENDER_COMMAND(TsMocapLatencyRender)([UpdateTime, OriginTime = PoseOriginTime](FRHICommandListImmediate& RHICmdList)
+        {
+            const double RenderTime = FPlatformTime::Seconds();
+            TsMocapLatency::Record(TsMocapLatency::EStage::Render, RenderTime - UpdateTime);
+            TsMocapLatency::Record(TsMocapLatency::EStage::Total, RenderTime - OriginTime);
+        });
+        PosePickupTime = 0.0;
+    }
+}
+
+void UTsMotionAnimation::SetRequiredBones(const void* Node, std::uint64_t Mask)
+{
+    FScopeLock Lock(&RequiredBonesLock);
+    RequiredBones[Node] = Mask;
+}
+
+std::uint64_t UTsMotionAnimation::GetRequiredBones() const
+{
+    FScopeLock Lock(&RequiredBonesLock);
+    std::uint64_t Mask = 0;
+    for (const auto& It : RequiredBones)
+    {
+        Mask |= It.second;
+    }
+    return Mask;
+}
+
+void UTsMotionAnimation::SetEvaluatedBones(std::uint64_t Mask)
+{
+    EvaluatedBones.store(Mask, std::memory_order_relaxed);
+}
+
+std::uint64_t UTsMotionAnimation::GetEvaluatedBones() const
+{
+    return EvaluatedBones.load(std::memory_order_relaxed);
+}
+
+void UTsMotionAnimation::SetPoseTimes(double OriginTime, double PickupTime)
+{
+    PoseOriginTime = OriginTime;
+    PosePickupTime = PickupTime;
+}
+
+void UTsMotionAnimation::SetPoseRotations(std::uint64_t Mask, const FQuat4f* Rotations)
+{
+    for (auto Bits = Mask; Bits != 0; Bits &= Bits - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Bits);
+        PendingPoseRotations[Index] = Rotations[Index];
+    }
+    PendingPoseMask |= Mask;
+}
+
+void UTsMotionAnimation::ResetPose()
+{
+    PendingPoseMask = 0;
 }
@@ -0,0 +1,183 @@
+#include "Motion/TsRetargetProfile.h"
+#include "Animation/Skeleton.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_EDITOR
+namespace
+{
+    const int32 BodyBonesCount = static_cast<int32>(FTsBoneIndex::TsBoneIndex_LeftThumbProximal);
+
+    // Normalized names of body bones in Unreal mannequin, Mixamo and Unity humanoid conventions
+    const TCHAR* const BodyBoneNames[BodyBonesCount][4] =
+    {
+        { TEXT("pelvis"), TEXT("hips"), TEXT("hip"), nullptr },
+        { TEXT("thighl"), TEXT("leftupleg"), TEXT("leftupperleg"), TEXT("leftthigh") },
+        { TEXT("thighr"), TEXT("rightupleg"), TEXT("rightupperleg"), TEXT("rightthigh") },
+        { TEXT("calfl"), TEXT("leftleg"), TEXT("leftlowerleg"), TEXT("leftcalf") },
+        { TEXT("calfr"), TEXT("rightleg"), TEXT("rightlowerleg"), TEXT("rightcalf") },
+        { TEXT("footl"), TEXT("leftfoot"), nullptr, nullptr },
+        { TEXT("footr"), TEXT("rightfoot"), nullptr, nullptr },
+        { TEXT("spine01"), TEXT("spine"), nullptr, nullptr },
+        { TEXT("spine02"), TEXT("spine1"), TEXT("chest"), nullptr },
+        { TEXT("spine03"), TEXT("spine2"), TEXT("upperchest"), TEXT("upperspine") },
+        { TEXT("neck01"), TEXT("neck"), nullptr, nullptr },
+        { TEXT("head"), nullptr, nullptr, nullptr },
+        { TEXT("claviclel"), TEXT("leftshoulder"), TEXT("shoulderl"), nullptr },
+        { TEXT("clavicler"), TEXT("rightshoulder"), TEXT("shoulderr"), nullptr },
+        { TEXT("upperarml"), TEXT("leftarm"), TEXT("leftupperarm"), nullptr },
+        { TEXT("upperarmr"), TEXT("rightarm"), TEXT("rightupperarm"), nullptr },
+        { TEXT("lowerarml"), TEXT("leftforearm"), TEXT("leftlowerarm"), TEXT("forearml") },
+        { TEXT("lowerarmr"), TEXT("rightforearm"), TEXT("rightlowerarm"), TEXT("forearmr") },
+        { TEXT("handl"), TEXT("lefthand"), nullptr, nullptr },
+        { TEXT("handr"), TEXT("righthand"), nullptr, nullptr }
+    };
+
+    // Fingers follow body bones, left hand first, each finger has three segments
+    const TCHAR* const FingerNames[5][2] =
+    {
+        { TEXT("thumb"), TEXT("thumb") },
+        { TEXT("index"), TEXT("index") },
+        { TEXT("middle"), TEXT("middle") },
+        { TEXT("ring"), TEXT("ring") },
+        { TEXT("pinky"), TEXT("little") }
+    };
+    const TCHAR* const SegmentNames[3] = { TEXT("proximal"), TEXT("intermediate"), TEXT("distal") };
+
+    // Lowercase name without namespace prefix and separators
+    FString NormalizeName(const FString& Name)
+    {
+        int32 Separator = INDEX_NONE;
+        FString Result = Name.FindLastChar(TEXT(':'), Separator) ? Name.RightChop(Separator + 1) : Name;
+        Result.ToLowerInline();
+        Result.ReplaceInline(TEXT("_"), TEXT(""));
+        Result.ReplaceInline(TEXT(" "), TEXT(""));
+        Result.ReplaceInline(TEXT("."), TEXT(""));
+        return Result;
+    }
+
+    TArray<FString> GetCandidateNames(int32 MocapBone)
+    {
+        TArray<FString> Names;
+        if (MocapBone < BodyBonesCount)
+        {
+            for (const TCHAR* Name : BodyBoneNames[MocapBone])
+            {
+                if (Name != nullptr)
+                {
+                    Names.Add(Name);
+                }
+            }
+            return Names;
+        }
+        const int32 FingerBone = MocapBone - BodyBonesCount;
+        const bool bLeft = FingerBone < 15;
+        const int32 Segment = FingerBone % 3;
+        const auto& Finger = FingerNames[(FingerBone % 15) / 3];
+        const TCHAR* Side = bLeft ? TEXT("left") : TEXT("right");
+        const TCHAR* Suffix = bLeft ? TEXT("l") : TEXT("r");
+        Names.Add(FString::Printf(TEXT("%s0%d%s"), Finger[0], Segment + 1, Suffix));
+        Names.Add(FString::Printf(TEXT("%shand%s%d"), Side, Finger[0], Segment + 1));
+        Names.Add(FString::Printf(TEXT("%s%s%s"), Side, Finger[1], SegmentNames[Segment]));
+        return Names;
+    }
+}
+#endif
+
+std::shared_ptr<const TsRetargetTable> UTsRetargetProfile::GetTable(const USkeleton* TargetSkeleton) const
+{
+    if (TargetSkeleton == nullptr)
+    {
+        return nullptr;
+    }
+
+    FScopeLock Lock(&TablesLock);
+    if (const auto Table = Tables.Find(TargetSkeleton))
+    {
+        return *Table;
+    }
+
+    const auto& RefSkeleton = TargetSkeleton->GetReferenceSkeleton();
+    struct Entry
+    {
+        int32 SkeletonBone;
+        uint8 MocapBone;
+        FQuat Offset;
+    };
+    TArray<Entry> Entries;
+    for (const auto& It : Bones)
+    {
+        const int32 SkeletonBone = RefSkeleton.FindBoneIndex(It.Value.BoneName);
+        if (SkeletonBone == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UTsRetargetProfile: bone %s of %s not found in skeleton %s."),
+                *It.Value.BoneName.ToString(), *GetName(), *TargetSkeleton->GetName());
+            continue;
+        }
+        Entries.Add({ SkeletonBone, static_cast<uint8>(It.Key), It.Value.Offset.Quaternion().GetNormalized() });
+    }
+    Entries.Sort([](const Entry& A, const Entry& B) { return A.SkeletonBone < B.SkeletonBone; });
+
+    auto Table = std::make_shared<TsRetargetTable>();
+    for (const auto& Item : Entries)
+    {
+        Table->SkeletonBones.Add(Item.SkeletonBone);
+        Table->MocapBones.Add(Item.MocapBone);
+        Table->Offsets.Add(Item.Offset);
+    }
+    Tables.Add(TargetSkeleton, Table);
+    return Table;
+}
+
+#if WITH_EDITOR
+void UTsRetargetProfile::AutoMap()
+{
+    if (Skeleton == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsRetargetProfile: failed to auto map %s - no skeleton."), *GetName());
+        return;
+    }
+    Modify();
+
+    const auto& RefSkeleton = Skeleton->GetReferenceSkeleton();
+    const auto& RefPose = RefSkeleton.GetRefBonePose();
+    TMap<FString, int32> BonesByName;
+    TArray<FQuat> ComponentRotations;
+    ComponentRotations.SetNum(RefSkeleton.GetNum());
+    for (int32 Bone = 0; Bone < RefSkeleton.GetNum(); ++Bone)
+    {
+        // First of bones with equal normalized names wins, it's the closest to the root
+        BonesByName.FindOrAdd(NormalizeName(RefSkeleton.GetBoneName(Bone).ToString()), Bone);
+        const int32 Parent = RefSkeleton.GetParentIndex(Bone);
+        ComponentRotations[Bone] = Parent != INDEX_NONE ? ComponentRotations[Parent] * RefPose[Bone].GetRotation() : RefPose[Bone].GetRotation();
+    }
+
+    int32 Mapped = 0;
+    for (int32 MocapBone = 0; MocapBone < static_cast<int32>(FTsBoneIndex::TsBoneIndex_BonesCount); ++MocapBone)
+    {
+        for (const auto& Name : GetCandidateNames(MocapBone))
+        {
+            if (const int32* Bone = BonesByName.Find(Name))
+            {
+                auto& Mapping = Bones.FindOrAdd(static_cast<FTsBoneIndex>(MocapBone));
+                Mapping.BoneName = RefSkeleton.GetBoneName(*Bone);
+                Mapping.Offset = ComponentRotations[*Bone].GetNormalized().Rotator();
+                ++Mapped;
+                break;
+            }
+        }
+    }
+    UE_LOG(LogTemp, Log, TEXT("UTsRetargetProfile: auto mapped %d bones of %s to %s."), Mapped, *GetName(), *Skeleton->GetName());
+
+    FScopeLock Lock(&TablesLock);
+    Tables.Empty();
+}
+
+void UTsRetargetProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Anim nodes pick up recompiled tables when their bone references are initialized again
+    FScopeLock Lock(&TablesLock);
+    Tables.Empty();
+}
+#endif
@@ -0,0 +1,8 @@
+#include "Sequencer/MovieSceneTsHapticSection.h"
+
+UMovieSceneTsHapticSection::UMovieSceneTsHapticSection(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    // Haptic is not restored to pre-sequence state, playables are released when section stops evaluating
+    EvalOptions.EnableAndSetCompletionMode(EMovieSceneCompletionMode::KeepState);
+}
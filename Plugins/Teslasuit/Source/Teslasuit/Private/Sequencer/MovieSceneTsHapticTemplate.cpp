@@ -0,0 +1,282 @@
+#include "Sequencer/MovieSceneTsHapticTemplate.h"
+#include "Evaluation/MovieSceneExecutionTokens.h"
+#include "Evaluation/PersistentEvaluationData.h"
+#include "GameFramework/Actor.h"
+#include "IMovieScenePlayer.h"
+#include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+#include "Haptic/TsHapticPlayablePool.h"
+#include "Haptic/TsHapticPlayer.h"
+#include "Haptic/TsHapticVoiceManager.h"
+#include "Sequencer/MovieSceneTsHapticSection.h"
+#include "ts_api/ts_haptic_api.h"
+
+namespace
+{
+    const double MaxLatencySeconds = 0.5;
+
+    struct FTsHapticPlayback
+    {
+        void* DeviceHandle = nullptr;
+        std::uint64_t PlayableId = 0;
+        double Duration = 0.0;
+        bool bPlaying = false;
+        bool bAssetLoaded = false;
+
+        // Device clock and playable position at the last synchronization
+        std::uint64_t PlayerTimeAtSync = 0;
+        std::uint64_t LocalTimeAtSync = 0;
+        double WallTimeAtSync = 0.0;
+        bool bLatencyMeasured = false;
+    };
+
+    struct FTsHapticSectionData : IPersistentEvaluationData
+    {
+        TArray<FTsHapticPlayback> Playbacks;
+    };
+
+    struct FTsHapticApi
+    {
+        decltype(&ts_haptic_play_playable) PlayFn = nullptr;
+        decltype(&ts_haptic_stop_playable) StopFn = nullptr;
+        decltype(&ts_haptic_get_player_time) GetPlayerTimeFn = nullptr;
+        decltype(&ts_haptic_get_playable_local_time) GetLocalTimeFn = nullptr;
+        decltype(&ts_haptic_set_playable_local_time) SetLocalTimeFn = nullptr;
+        decltype(&ts_haptic_get_playable_duration) GetDurationFn = nullptr;
+
+        explicit FTsHapticApi(void* LibHandle)
+        {
+            PlayFn = reinterpret_cast<decltype(PlayFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_play_playable")));
+            StopFn = reinterpret_cast<decltype(StopFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_stop_playable")));
+            GetPlayerTimeFn = reinterpret_cast<decltype(GetPlayerTimeFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_player_time")));
+            GetLocalTimeFn = reinterpret_cast<decltype(GetLocalTimeFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_local_time")));
+            SetLocalTimeFn = reinterpret_cast<decltype(SetLocalTimeFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_set_playable_local_time")));
+            GetDurationFn = reinterpret_cast<decltype(GetDurationFn)>(FPlatformProcess::GetDllExport(LibHandle, *FString("ts_haptic_get_playable_duration")));
+        }
+
+        bool IsValid() const
+        {
+            return PlayFn != nullptr && StopFn != nullptr && GetPlayerTimeFn != nullptr &&
+                GetLocalTimeFn != nullptr && SetLocalTimeFn != nullptr && GetDurationFn != nullptr;
+        }
+    };
+
+    const FTsHapticApi& GetApi()
+    {
+        static const FTsHapticApi Api(ITeslasuitPlugin::Get().GetLibHandle());
+        return Api;
+    }
+
+    UTsDevice* FindDevice(UObject* Object)
+    {
+        auto Player = Cast<UTsHapticPlayer>(Object);
+        if (Player == nullptr)
+        {
+            auto Actor = Cast<AActor>(Object);
+            Player = Actor != nullptr ? Actor->FindComponentByClass<UTsHapticPlayer>() : nullptr;
+        }
+        auto Device = Player != nullptr ? Player->GetTsDevice() : nullptr;
+        return Device != nullptr && Device->IsConnected() && Device->Handle != nullptr ? Device : nullptr;
+    }
+
+    void StopPlayback(FTsHapticPlayback& Playback)
+    {
+        if (Playback.bPlaying)
+        {
+            GetApi().StopFn(reinterpret_cast<TsDeviceHandle*>(Playback.DeviceHandle), Playback.PlayableId);
+            Playback.bPlaying = false;
+        }
+    }
+
+    void SyncPlayback(FTsHapticPlayback& Playback, double Position)
+    {
+        // Jump playable to the position and remember device clock to track drift
+        const auto& Api = GetApi();
+        auto Device = reinterpret_cast<TsDeviceHandle*>(Playback.DeviceHandle);
+        const std::uint64_t LocalTime = static_cast<std::uint64_t>(Position * 1000.0);
+        Api.SetLocalTimeFn(Device, Playback.PlayableId, LocalTime);
+        if (!Playback.bPlaying)
+        {
+            Api.PlayFn(Device, Playback.PlayableId);
+            Playback.bPlaying = true;
+        }
+        Api.GetPlayerTimeFn(Device, &Playback.PlayerTimeAtSync);
+        Playback.LocalTimeAtSync = LocalTime;
+        Playback.WallTimeAtSync = FPlatformTime::Seconds();
+        Playback.bLatencyMeasured = false;
+    }
+
+    /*!
+        \brief Returns playable position drift from the target position in seconds.
+
+        Expected position is extrapolated from the last sync point with device player clock.
+        First check after a sync also measures command latency: playable advanced less than
+        wall time since the sync by the time the sync took to reach the device.
+    */
+    double MeasureDrift(FTsHapticPlayback& Playback, double Position)
+    {
+        const auto& Api = GetApi();
+        auto Device = reinterpret_cast<TsDeviceHandle*>(Playback.DeviceHandle);
+        std::uint64_t PlayerTime = 0;
+        std::uint64_t LocalTime = 0;
+        if (Api.GetPlayerTimeFn(Device, &PlayerTime) != 0 || Api.GetLocalTimeFn(Device, Playback.PlayableId, &LocalTime) != 0)
+        {
+            return 0.0;
+        }
+        if (!Playback.bLatencyMeasured)
+        {
+            Playback.bLatencyMeasured = true;
+            const double Advanced = (static_cast<double>(LocalTime) - static_cast<double>(Playback.LocalTimeAtSync)) / 1000.0;
+            const double Latency = FPlatformTime::Seconds() - Playback.WallTimeAtSync - Advanced;
+            if (Latency >= 0.0 && Latency <= MaxLatencySeconds)
+            {
+                ITeslasuitPlugin::Get().GetHapticVoiceManager().ReportCommandLatency(Playback.DeviceHandle, Latency);
+            }
+        }
+        const double Expected = (Playback.LocalTimeAtSync + (PlayerTime - Playback.PlayerTimeAtSync)) / 1000.0;
+        return Expected - Position;
+    }
+
+    struct FTsHapticExecutionToken : IMovieSceneExecutionToken
+    {
+        FTsHapticExecutionToken(const FMovieSceneTsHapticSectionTemplate& InTemplate)
+            : Template(InTemplate)
+        {
+        }
+
+        virtual void Execute(const FMovieSceneContext& Context, const FMovieSceneEvaluationOperand& Operand, FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) override
+        {
+            if (Template.Asset == nullptr || !GetApi().IsValid())
+            {
+                return;
+            }
+            auto& Data = PersistentData.GetOrAddSectionData<FTsHapticSectionData>();
+
+            // Section local time with sub-frame precision, negative during pre-roll
+            const double SectionTime = Context.GetFrameRate().AsSeconds(Context.GetTime() - Template.SectionStart) + Template.StartOffset;
+            const bool bPlaying = Context.GetStatus() == EMovieScenePlayerStatus::Playing &&
+                Context.GetDirection() == EPlayDirection::Forwards && !Context.IsSilent();
+
+            for (TWeakObjectPtr<> WeakObject : Player.FindBoundObjects(Operand))
+            {
+                auto Device = FindDevice(WeakObject.Get());
+                if (Device == nullptr)
+                {
+                    continue;
+                }
+                auto& Playback = FindOrCreatePlayback(Data, Device->Handle);
+                if (Playback.PlayableId == 0)
+                {
+                    continue;
+                }
+                if (!bPlaying)
+                {
+                    StopPlayback(Playback);
+                    continue;
+                }
+
+                // Lead the sequence by device latency so haptic is felt with the picture
+                const double Latency = Template.bCompensateLatency ?
+                    ITeslasuitPlugin::Get().GetHapticVoiceManager().GetCommandLatency(Device->Handle) + Template.ExtraLatencyMs / 1000.0 : 0.0;
+                const double Position = SectionTime + Latency;
+                if (Position < 0.0 || (Playback.Duration > 0.0 && Position >= Playback.Duration))
+                {
+                    StopPlayback(Playback);
+                    continue;
+                }
+                if (!Playback.bPlaying || Context.HasJumped())
+                {
+                    SyncPlayback(Playback, Position);
+                    continue;
+                }
+
+                // Check drift once latest sync had time to reach the device
+                const double SettleTime = FMath::Max(Latency, Context.GetFrameRate().AsSeconds(Context.GetDelta()));
+                if (FPlatformTime::Seconds() - Playback.WallTimeAtSync > SettleTime &&
+                    FMath::Abs(MeasureDrift(Playback, Position)) * 1000.0 > Template.ResyncThresholdMs)
+                {
+                    SyncPlayback(Playback, Position);
+                }
+            }
+        }
+
+        FTsHapticPlayback& FindOrCreatePlayback(FTsHapticSectionData& Data, void* DeviceHandle)
+        {
+            auto Existing = Data.Playbacks.FindByPredicate([DeviceHandle](const FTsHapticPlayback& Item) { return Item.DeviceHandle == DeviceHandle; });
+            if (Existing != nullptr)
+            {
+                return *Existing;
+            }
+
+            // Playable is created once, on first evaluation in pre-roll
+            auto& Playback = Data.Playbacks.AddDefaulted_GetRef();
+            Playback.DeviceHandle = DeviceHandle;
+            auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+            auto AssetHandle = AM.LoadAsset(*Template.Asset);
+            if (AssetHandle == nullptr)
+            {
+                UE_LOG(LogTemp, Error, TEXT("FMovieSceneTsHapticSectionTemplate: failed to create playable - asset is not loaded."));
+                return Playback;
+            }
+            Playback.bAssetLoaded = true;
+            Playback.PlayableId = ITeslasuitPlugin::Get().GetHapticPlayablePool().Acquire(DeviceHandle, AssetHandle);
+
+            // Duration is taken from asset metadata or queried once per playback
+            Playback.Duration = Template.Asset->GetDuration();
+            std::uint64_t DurationMs = 0;
+            if (Playback.Duration == 0.0 && Playback.PlayableId != 0 &&
+                GetApi().GetDurationFn(reinterpret_cast<TsDeviceHandle*>(DeviceHandle), Playback.PlayableId, &DurationMs) == 0)
+            {
+                Playback.Duration = DurationMs / 1000.0;
+            }
+            return Playback;
+        }
+
+        FMovieSceneTsHapticSectionTemplate Template;
+    };
+}
+
+FMovieSceneTsHapticSectionTemplate::FMovieSceneTsHapticSectionTemplate(const UMovieSceneTsHapticSection& Section)
+    : Asset(Section.Asset)
+    , SectionStart(Section.HasStartFrame() ? Section.GetInclusiveStartFrame() : FFrameNumber(0))
+    , StartOffset(Section.StartOffset)
+    , bCompensateLatency(Section.bCompensateLatency)
+    , ExtraLatencyMs(Section.ExtraLatencyMs)
+    , ResyncThresholdMs(Section.ResyncThresholdMs)
+{
+    EnableOverrides(RequiresTearDownFlag);
+}
+
+void FMovieSceneTsHapticSectionTemplate::Evaluate(const FMovieSceneEvaluationOperand& Operand, const FMovieSceneContext& Context, const FPersistentEvaluationData& PersistentData, FMovieSceneExecutionTokens& ExecutionTokens) const
+{
+    ExecutionTokens.Add(FTsHapticExecutionToken(*this));
+}
+
+void FMovieSceneTsHapticSectionTemplate::TearDown(FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) const
+{
+    auto Data = PersistentData.FindSectionData<FTsHapticSectionData>();
+    if (Data == nullptr)
+    {
+        return;
+    }
+
+    // Section left evaluation, return its playables to the pool and release the asset loads they hold
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    auto& Pool = ITeslasuitPlugin::Get().GetHapticPlayablePool();
+    for (auto& Playback : Data->Playbacks)
+    {
+        if (Playback.PlayableId != 0)
+        {
+            StopPlayback(Playback);
+            Pool.Release(Playback.DeviceHandle, Playback.PlayableId);
+        }
+    }
+    for (auto& Playback : Data->Playbacks)
+    {
+        if (Playback.bAssetLoaded && Asset != nullptr)
+        {
+            AM.UnloadAsset(*Asset);
+        }
+    }
+    Data->Playbacks.Empty();
+}
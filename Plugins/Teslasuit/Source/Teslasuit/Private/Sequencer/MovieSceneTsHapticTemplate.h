@@ -0,0 +1,42 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Evaluation/MovieSceneEvalTemplate.h"
+#include "TsAsset.h"
+#include "MovieSceneTsHapticTemplate.generated.h"
+
+class UMovieSceneTsHapticSection;
+
+/*!
+    \brief Evaluation template of #UMovieSceneTsHapticSection.
+*/
+USTRUCT()
+struct FMovieSceneTsHapticSectionTemplate : public FMovieSceneEvalTemplate
+{
+    GENERATED_BODY()
+
+    FMovieSceneTsHapticSectionTemplate() = default;
+    FMovieSceneTsHapticSectionTemplate(const UMovieSceneTsHapticSection& Section);
+
+    UPROPERTY()
+    UTsAsset* Asset = nullptr;
+
+    UPROPERTY()
+    FFrameNumber SectionStart;
+
+    UPROPERTY()
+    float StartOffset = 0.0f;
+
+    UPROPERTY()
+    bool bCompensateLatency = true;
+
+    UPROPERTY()
+    float ExtraLatencyMs = 0.0f;
+
+    UPROPERTY()
+    float ResyncThresholdMs = 20.0f;
+
+private:
+    virtual UScriptStruct& GetScriptStructImpl() const override { return *StaticStruct(); }
+    virtual void Evaluate(const FMovieSceneEvaluationOperand& Operand, const FMovieSceneContext& Context, const FPersistentEvaluationData& PersistentData, FMovieSceneExecutionTokens& ExecutionTokens) const override;
+    virtual void TearDown(FPersistentEvaluationData& PersistentData, IMovieScenePlayer& Player) const override;
+};
@@ -0,0 +1,81 @@
+#include "Sequencer/MovieSceneTsHapticTrack.h"
+#include "MovieScene.h"
+#include "Sequencer/MovieSceneTsHapticSection.h"
+#include "Sequencer/MovieSceneTsHapticTemplate.h"
+
+#define LOCTEXT_NAMESPACE "Teslasuit"
+
+UMovieSceneTsHapticTrack::UMovieSceneTsHapticTrack(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    // Pre-roll evaluation creates playables before sections start
+    EvalOptions.bEvaluateInPreroll = true;
+#if WITH_EDITORONLY_DATA
+    TrackTint = FColor(40, 120, 160, 150);
+#endif
+}
+
+bool UMovieSceneTsHapticTrack::SupportsType(TSubclassOf<UMovieSceneSection> SectionClass) const
+{
+    return SectionClass == UMovieSceneTsHapticSection::StaticClass();
+}
+
+UMovieSceneSection* UMovieSceneTsHapticTrack::CreateNewSection()
+{
+    auto Section = NewObject<UMovieSceneTsHapticSection>(this, NAME_None, RF_Transactional);
+    auto MovieScene = GetTypedOuter<UMovieScene>();
+    if (MovieScene != nullptr)
+    {
+        Section->SetPreRollFrames((PreRollSeconds * MovieScene->GetTickResolution()).RoundToFrame().Value);
+    }
+    return Section;
+}
+
+const TArray<UMovieSceneSection*>& UMovieSceneTsHapticTrack::GetAllSections() const
+{
+    return Sections;
+}
+
+bool UMovieSceneTsHapticTrack::HasSection(const UMovieSceneSection& Section) const
+{
+    return Sections.Contains(&Section);
+}
+
+void UMovieSceneTsHapticTrack::AddSection(UMovieSceneSection& Section)
+{
+    Sections.Add(&Section);
+}
+
+void UMovieSceneTsHapticTrack::RemoveSection(UMovieSceneSection& Section)
+{
+    Sections.Remove(&Section);
+}
+
+void UMovieSceneTsHapticTrack::RemoveSectionAt(int32 SectionIndex)
+{
+    Sections.RemoveAt(SectionIndex);
+}
+
+bool UMovieSceneTsHapticTrack::IsEmpty() const
+{
+    return Sections.Num() == 0;
+}
+
+void UMovieSceneTsHapticTrack::RemoveAllAnimationData()
+{
+    Sections.Empty();
+}
+
+#if WITH_EDITORONLY_DATA
+FText UMovieSceneTsHapticTrack::GetDefaultDisplayName() const
+{
+    return LOCTEXT("TsHapticTrackName", "Teslasuit Haptic");
+}
+#endif
+
+FMovieSceneEvalTemplatePtr UMovieSceneTsHapticTrack::CreateTemplateForSection(const UMovieSceneSection& InSection) const
+{
+    return FMovieSceneTsHapticSectionTemplate(*CastChecked<const UMovieSceneTsHapticSection>(&InSection));
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,6 +2,12 @@
 
 #define LOCTEXT_NAMESPACE "FTeslasuitModule"
 
+namespace
+{
+    // Pool recycles finished playables at this period, polling them every frame costs API calls
+    const float PoolUpdatePeriod = 0.1f;
+}
+
 void FTeslasuitModule::StartupModule()
 {
 	UE_LOG(LogTemp, Log, TEXT("FTeslasuitModule: startup module"));
@@ -9,15 +15,46 @@ void FTeslasuitModule::StartupModule()
     Core = std::make_unique<TsCore>();
     DeviceProvider = std::make_unique<TsDeviceProvider>();
     HapticAssetManager = std::make_unique<TsHapticAssetManager>();
+    HapticPlayablePool = std::make_unique<TsHapticPlayablePool>();
+    HapticThread = std::make_unique<TsHapticThread>();
+    HapticVoiceManager = std::make_unique<TsHapticVoiceManager>();
 
     Core->Initialize();
     DeviceProvider->SetLibHandle(GetLibHandle());
     HapticAssetManager->SetLibHandle(GetLibHandle());
+    HapticPlayablePool->SetLibHandle(GetLibHandle());
+    HapticVoiceManager->SetLibHandle(GetLibHandle());
+
+    // Pooled playables and voices die with their device
+    DeviceProvider->SubscribeOnDisconnect((intptr_t)HapticPlayablePool.get(), [this](const TsDeviceId& Id)
+    {
+        auto Handle = DeviceProvider->GetDeviceHandle(Id);
+        HapticPlayablePool->RemoveDevice(Handle);
+        HapticVoiceManager->RemoveDevice(Handle);
+        HapticAssetManager->RemoveDevice(Handle);
+    });
+    // Pooled playables must go before their asset is unloaded
+    HapticAssetManager->SubscribeOnUnload((intptr_t)HapticPlayablePool.get(), [this](void* AssetHandle)
+    {
+        HapticPlayablePool->RemoveAsset(AssetHandle);
+    });
+    PoolTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+    {
+        HapticPlayablePool->Update();
+        return true;
+    }), PoolUpdatePeriod);
     DeviceProvider->Start();
 }
 
 void FTeslasuitModule::ShutdownModule()
 {
+    // Execute pending haptic commands before releasing playables
+    HapticThread.reset();
+    DeviceProvider->UnSubscribeOnDisconnect((intptr_t)HapticPlayablePool.get());
+    FTSTicker::GetCoreTicker().RemoveTicker(PoolTickHandle);
+    HapticAssetManager->UnSubscribeOnUnload((intptr_t)HapticPlayablePool.get());
+    HapticVoiceManager.reset();
+    HapticPlayablePool.reset();
     HapticAssetManager.reset();
 
     DeviceProvider->Stop();
@@ -42,6 +79,21 @@ TsHapticAssetManager& FTeslasuitModule::GetHapticAssetManager()
     return *HapticAssetManager;
 }
 
+TsHapticPlayablePool& FTeslasuitModule::GetHapticPlayablePool()
+{
+    return *HapticPlayablePool;
+}
+
+TsHapticThread& FTeslasuitModule::GetHapticThread()
+{
+    return *HapticThread;
+}
+
+TsHapticVoiceManager& FTeslasuitModule::GetHapticVoiceManager()
+{
+    return *HapticVoiceManager;
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FTeslasuitModule, Teslasuit)
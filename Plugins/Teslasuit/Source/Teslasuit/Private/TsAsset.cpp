@@ -1,13 +1,207 @@
 #include "TsAsset.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/CustomVersion.h"
+#include "TsStats.h"
+#include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+#include "TsDeviceProvider.h"
+
+DECLARE_MEMORY_STAT(TEXT("Haptic Asset Resident Payload"), STAT_TsAssetResidentPayload, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Haptic Asset Payload Read"), STAT_TsAssetPayloadRead, STATGROUP_Teslasuit);
+
+namespace
+{
+    struct FTsAssetCustomVersion
+    {
+        enum Type
+        {
+            BeforeCustomVersion = 0,
+            BulkDataPayload = 1,
+
+            VersionPlusOne,
+            LatestVersion = VersionPlusOne - 1
+        };
+
+        static const FGuid GUID;
+    };
+
+    const FGuid FTsAssetCustomVersion::GUID(0x5A1C0E37, 0x7B2F4D18, 0x9E6A31C4, 0x2D8F0B65);
+    FCustomVersionRegistration GRegisterTsAssetCustomVersion(FTsAssetCustomVersion::GUID, FTsAssetCustomVersion::LatestVersion, TEXT("TsAssetVer"));
+
+    const uint32 PayloadFlags = BULKDATA_SerializeCompressed | BULKDATA_Force_NOT_InlinePayload;
+}
 
 void UTsAsset::Initialize(const uint8* Data_, std::size_t Size_)
 {
     Data.Empty();
-    Data.Append(Data_, Size_);
-    UE_LOG(LogTemp, Log, TEXT("UTsAsset: initialized, size: %i."), Data.Num());
+    Payload.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(Payload.Realloc(Size_), Data_, Size_);
+    Payload.Unlock();
+    Payload.SetBulkDataFlags(PayloadFlags);
+
+    FSHAHash Hash;
+    FSHA1::HashBuffer(Data_, Size_, Hash.Hash);
+    ContentHash = Hash.ToString();
+    UE_LOG(LogTemp, Log, TEXT("UTsAsset: initialized, size: %lld."), Payload.GetBulkDataSize());
+}
+
+void UTsAsset::PreloadPayload() const
+{
+    FScopeLock Lock(&PayloadLock);
+    if (ResidentPayload.Num() > 0 || (PendingRead.IsValid() && !PendingRead.IsReady()))
+    {
+        return;
+    }
+    bDiscardPendingRead = false;
+    PendingRead = Async(EAsyncExecution::ThreadPool, [this]()
+    {
+        SetResidentPayload(ReadPayload());
+    });
+}
+
+TArray<uint8> UTsAsset::AcquirePayload() const
+{
+    TFuture<void> Read;
+    {
+        FScopeLock Lock(&PayloadLock);
+        Read = MoveTemp(PendingRead);
+    }
+    if (Read.IsValid())
+    {
+        Read.Wait();
+    }
+
+    FScopeLock Lock(&PayloadLock);
+    if (ResidentPayload.Num() == 0)
+    {
+        return ReadPayload();
+    }
+    DEC_MEMORY_STAT_BY(STAT_TsAssetResidentPayload, ResidentPayload.GetAllocatedSize());
+    return MoveTemp(ResidentPayload);
+}
+
+void UTsAsset::ReleasePayload() const
+{
+    FScopeLock Lock(&PayloadLock);
+    bDiscardPendingRead = PendingRead.IsValid() && !PendingRead.IsReady();
+    DEC_MEMORY_STAT_BY(STAT_TsAssetResidentPayload, ResidentPayload.GetAllocatedSize());
+    ResidentPayload.Empty();
+}
+
+int64 UTsAsset::GetPayloadSize() const
+{
+    return Payload.GetBulkDataSize();
+}
+
+ETsAssetType UTsAsset::GetAssetType() const
+{
+    return AssetType;
+}
+
+float UTsAsset::GetDuration() const
+{
+    return Duration;
+}
+
+FString UTsAsset::GetContentHash() const
+{
+    return ContentHash;
+}
+
+void UTsAsset::SetAssetType(ETsAssetType Type)
+{
+    AssetType = Type;
+}
+
+void UTsAsset::SetDuration(float Seconds)
+{
+    Duration = Seconds;
+}
+
+void UTsAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    Ar.UsingCustomVersion(FTsAssetCustomVersion::GUID);
+    if (Ar.CustomVer(FTsAssetCustomVersion::GUID) >= FTsAssetCustomVersion::BulkDataPayload)
+    {
+        Payload.Serialize(Ar, this);
+    }
+}
+
+void UTsAsset::PostLoad()
+{
+    Super::PostLoad();
+
+    // Move payload of old assets to bulk data
+    TArray<uint8> Legacy;
+    if (Data.Num() > 0)
+    {
+        Legacy = MoveTemp(Data);
+        Initialize(Legacy.GetData(), Legacy.Num());
+    }
+#if WITH_EDITOR
+    // Old assets were imported without metadata, assets imported without connected device lack duration
+    if (!ITeslasuitPlugin::IsAvailable() || !IsInGameThread())
+    {
+        return;
+    }
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    const bool bDeviceConnected = !ITeslasuitPlugin::Get().GetDeviceProvider().GetDeviceIds().empty();
+    if (Legacy.Num() > 0 && (AssetType == ETsAssetType::Undefined || (Duration == 0.0f && bDeviceConnected)))
+    {
+        AssetType = AM.InspectAsset(Legacy.GetData(), Legacy.Num(), &Duration);
+    }
+    else if (Legacy.Num() == 0 && AssetType != ETsAssetType::Undefined && Duration == 0.0f && bDeviceConnected)
+    {
+        const TArray<uint8> Bytes = ReadPayload();
+        AM.InspectAsset(Bytes.GetData(), Bytes.Num(), &Duration);
+    }
+#endif
+}
+
+bool UTsAsset::IsReadyForFinishDestroy()
+{
+    FScopeLock Lock(&PayloadLock);
+    return Super::IsReadyForFinishDestroy() && (!PendingRead.IsValid() || PendingRead.IsReady());
+}
+
+void UTsAsset::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+    Super::GetResourceSizeEx(CumulativeResourceSize);
+    FScopeLock Lock(&PayloadLock);
+    CumulativeResourceSize.AddDedicatedSystemMemoryBytes(ResidentPayload.GetAllocatedSize());
+    if (Payload.IsBulkDataLoaded())
+    {
+        CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Payload.GetBulkDataSize());
+    }
+}
+
+TArray<uint8> UTsAsset::ReadPayload() const
+{
+    SCOPE_CYCLE_COUNTER(STAT_TsAssetPayloadRead);
+    TArray<uint8> Bytes;
+    Bytes.SetNumUninitialized(Payload.GetBulkDataSize());
+    if (Bytes.Num() > 0)
+    {
+        // Copy straight into the array and drop bulk data copy when it can be read again
+        void* Destination = Bytes.GetData();
+        const_cast<FByteBulkData&>(Payload).GetCopy(&Destination, true);
+    }
+    return Bytes;
 }
 
-const TArray<uint8>& UTsAsset::GetData() const
+void UTsAsset::SetResidentPayload(TArray<uint8>&& Bytes) const
 {
-    return Data;
+    FScopeLock Lock(&PayloadLock);
+    if (bDiscardPendingRead)
+    {
+        bDiscardPendingRead = false;
+        return;
+    }
+    DEC_MEMORY_STAT_BY(STAT_TsAssetResidentPayload, ResidentPayload.GetAllocatedSize());
+    ResidentPayload = MoveTemp(Bytes);
+    INC_MEMORY_STAT_BY(STAT_TsAssetResidentPayload, ResidentPayload.GetAllocatedSize());
 }
@@ -1,2 +1,51 @@
 #include "TsBlueprintFunctionLibrary.h"
 #include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+#include <algorithm>
+#include <vector>
+
+FTsHapticBroadcastResult UTsBlueprintFunctionLibrary::PlayHapticOnDevices(const TArray<UTsDevice*>& Devices, UTsAsset* Asset)
+{
+    FTsHapticBroadcastResult Result;
+    if (Asset == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsBlueprintFunctionLibrary: failed to play haptic on devices - null asset."));
+        return Result;
+    }
+
+    // Collect unique connected devices
+    std::vector<void*> Handles;
+    Handles.reserve(Devices.Num());
+    for (auto Device : Devices)
+    {
+        if (Device != nullptr && Device->IsConnected() && Device->Handle != nullptr &&
+            std::find(Handles.begin(), Handles.end(), Device->Handle) == Handles.end())
+        {
+            Handles.push_back(Device->Handle);
+        }
+    }
+    if (Handles.empty())
+    {
+        return Result;
+    }
+
+    const auto Broadcast = ITeslasuitPlugin::Get().GetHapticAssetManager().PlayOnDevices(Handles, *Asset);
+    Result.DeviceCount = Broadcast.Played;
+    Result.SkewMs = static_cast<float>(Broadcast.SkewMs);
+    return Result;
+}
+
+FTsHapticBroadcastResult UTsBlueprintFunctionLibrary::PlayHapticOnAllDevices(UTsDeviceManager* DeviceManager, UTsAsset* Asset)
+{
+    if (DeviceManager == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsBlueprintFunctionLibrary: failed to play haptic on all devices - null device manager."));
+        return FTsHapticBroadcastResult();
+    }
+    TArray<UTsDevice*> Devices;
+    for (uint8 Index = 0; Index < static_cast<uint8>(EDeviceIndex::Count); ++Index)
+    {
+        Devices.Add(DeviceManager->GetDevice(static_cast<EDeviceIndex>(Index)));
+    }
+    return PlayHapticOnDevices(Devices, Asset);
+}
@@ -3,10 +3,57 @@
 
 #include "TsMocap.h"
 #include <Async/Async.h>
+#include <array>
+#include <vector>
 #include "ITeslasuitPlugin.h"
+#include "HAL/IConsoleManager.h"
+#include "TsDeviceProvider.h"
+#include "TsStats.h"
+#include "Motion/TsMocapConvert.h"
+#include "Motion/TsMocapFilter.h"
+#include "Motion/TsMocapIdleDetector.h"
+#include "Motion/TsMocapLatency.h"
+#include "Utils/TsCallbackGate.h"
+#include "Utils/TsSpscRing.h"
+#include "Utils/TsStreamMonitor.h"
+#include "Utils/TsStreamWorker.h"
 #include "ts_api/ts_device_api.h"
 #include "ts_api/ts_mocap_api.h"
 
+static TAutoConsoleVariable<float> CVarTsMocapGyroScale(
+    TEXT("Teslasuit.Mocap.GyroScale"),
+    PI / 180.0f,
+    TEXT("Radians per second in one unit of sensor gyroscope readings."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTsMocapAccelerationScale(
+    TEXT("Teslasuit.Mocap.AccelerationScale"),
+    1.0f,
+    TEXT("Meters per second squared in one unit of sensor linear acceleration readings, frame translations are in meters."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTsMocapIdleAngle(
+    TEXT("Teslasuit.Mocap.IdleAngle"),
+    0.25f,
+    TEXT("Largest bone rotation, in degrees, for which mocap pose counts as unchanged. 0 disables idle detection."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTsMocapIdleDistance(
+    TEXT("Teslasuit.Mocap.IdleDistance"),
+    0.05f,
+    TEXT("Largest bone translation, in Unreal units, for which mocap pose counts as unchanged. 0 disables idle detection."),
+    ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Mocap Frame Convert"), STAT_TsMocapConvert, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Mocap Frame Filter"), STAT_TsMocapFilter, STATGROUP_Teslasuit);
+DECLARE_CYCLE_STAT(TEXT("Mocap Idle Detection"), STAT_TsMocapIdle, STATGROUP_Teslasuit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Mocap Idle Frames"), STAT_TsMocapIdleFrames, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mocap Bones Streamed"), STAT_TsMocapBonesStreamed, STATGROUP_Teslasuit);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Mocap Raw Frames Dropped"), STAT_TsMocapRawDropped, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Rate (Hz)"), STAT_TsMocapRate, STATGROUP_Teslasuit);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Mocap Jitter p99 (ms)"), STAT_TsMocapJitter, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mocap Frames Lost"), STAT_TsMocapLost, STATGROUP_Teslasuit);
+
 static const auto BonesToTransform =
 {
     //Suit bones
@@ -62,43 +109,332 @@ static const auto BonesToTransform =
     TsBoneIndex::TsBoneIndex_LeftLittleDistal
 };
 
-decltype(&ts_mocap_start_streaming) StartMocapStreamingFn;
-decltype(&ts_mocap_stop_streaming) StopMocapStreamingFn;
-decltype(&ts_mocap_skeleton_calibrate) SkeletonCalibrateFn;
-decltype(&ts_mocap_set_skeleton_update_callback) SetSkeletonUpdateCallback;
-decltype(&ts_mocap_set_sensor_skeleton_update_callback) SetMocapSensorUpdateCallack;
-decltype(&ts_mocap_skeleton_get_bone) SkeletonGetBone;
-decltype(&ts_mocap_sensor_skeleton_get_bone) SkeletonGetSensorBone;
+namespace
+{
+    /*!
+        \brief Mocap functions of Teslasuit C API library.
+    */
+    struct MocapApi
+    {
+        decltype(&ts_mocap_start_streaming) StartStreamingFn = nullptr;
+        decltype(&ts_mocap_stop_streaming) StopStreamingFn = nullptr;
+        decltype(&ts_mocap_skeleton_calibrate) CalibrateFn = nullptr;
+        decltype(&ts_mocap_set_skeleton_update_callback) SetSkeletonCallbackFn = nullptr;
+        decltype(&ts_mocap_set_sensor_skeleton_update_callback) SetSensorCallbackFn = nullptr;
+        decltype(&ts_mocap_skeleton_get_bone) GetBoneFn = nullptr;
+        decltype(&ts_mocap_sensor_skeleton_get_bone) GetSensorBoneFn = nullptr;
+
+        static MocapApi Resolve()
+        {
+            auto LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
+
+            MocapApi Api;
+            Api.StartStreamingFn = reinterpret_cast<decltype(&ts_mocap_start_streaming)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_start_streaming")));
+            Api.StopStreamingFn = reinterpret_cast<decltype(&ts_mocap_stop_streaming)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_stop_streaming")));
+            Api.CalibrateFn = reinterpret_cast<decltype(&ts_mocap_skeleton_calibrate)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_skeleton_calibrate")));
+            Api.SetSkeletonCallbackFn = reinterpret_cast<decltype(&ts_mocap_set_skeleton_update_callback)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_set_skeleton_update_callback")));
+            Api.SetSensorCallbackFn = reinterpret_cast<decltype(&ts_mocap_set_sensor_skeleton_update_callback)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_set_sensor_skeleton_update_callback")));
+            Api.GetBoneFn = reinterpret_cast<decltype(&ts_mocap_skeleton_get_bone)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_skeleton_get_bone")));
+            Api.GetSensorBoneFn = reinterpret_cast<decltype(&ts_mocap_sensor_skeleton_get_bone)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_sensor_skeletone_get_bone")));
+            return Api;
+        }
+    };
+
+    std::uint64_t GetTransformedMask()
+    {
+        std::uint64_t Mask = 0;
+        for (const auto BoneIndex : BonesToTransform)
+        {
+            Mask |= 1ull << static_cast<int32>(BoneIndex);
+        }
+        return Mask;
+    }
+
+    const std::uint64_t TransformedMask = GetTransformedMask();
+
+    // Suit reports bone translations in meters, frames keep them unscaled
+    const float UnrealUnitsPerMeter = 100.0f;
+
+    // Mocap data reader releases its bones when it isn't read for this long, in seconds
+    const double DataReaderTimeout = 1.0;
+
+    /*!
+        \brief Bones as received from device, before conversion.
+    */
+    struct RawSkeleton
+    {
+        TsMocapBone Bones[TsMocapFrame::BonesCount];
+        std::uint64_t Mask = 0;
+        double CaptureTime = 0.0;
+    };
+
+    /*!
+        \brief Sensor readings as received from device.
+    */
+    struct RawSensors
+    {
+        TsVec3f Gyro[TsMocapFrame::BonesCount];
+        TsVec3f Acceleration[TsMocapFrame::BonesCount];
+        std::uint64_t Mask = 0;
+        /*! Hips sensor timestamp, 0 if hips weren't read. */
+        std::uint64_t DeviceTimestamp = 0;
+        double ArrivalTime = 0.0;
+        /*! Platform time of the readings mapped from device clock by worker, 0 if unknown. */
+        double DeviceTime = 0.0;
+    };
+
+    using RotationOffsetArray = std::array<FQuat4f, TsMocapFrame::BonesCount>;
+}
+
+/*!
+    \brief Mocap stream of a single device, shared by all #UTsMocap objects of the device.
 
-TsMocapBone UpdateBone;
+    Owns device callbacks, stream worker and frame bus, streaming stops with the last owner.
+    Nothing is shared between streams, so suits stream independently. Fields are grouped
+    by the thread writing them, each group on its own cache lines.
+*/
+struct alignas(64) UTsMocap::StreamState
+{
+    // Game thread, set up before streaming
+    MocapApi Api;
+    TsDeviceId DeviceId;
+    void* DeviceHandle = nullptr;
+    std::map<const void*, std::uint64_t> RequiredBones;
+    std::shared_ptr<TsMocapFrameBus> FrameBus;
+    std::unique_ptr<TsStreamWorker> Worker;
+
+    // Game thread, rarely changed and read by callbacks and worker
+    alignas(64) TsCallbackGate Gate;
+    std::atomic<std::uint64_t> RequiredMask{ TransformedMask };
+    std::shared_ptr<const RotationOffsetArray> RotationOffsets;
+    std::shared_ptr<const TsMocapFilterParams> FilterParams;
+
+    // Device callbacks
+    alignas(64) TsSpscRing<RawSkeleton, 16> RawFrames;
+    TsSpscRing<RawSensors, 4> RawSensorFrames;
+    TsStreamMonitor Monitor;
+
+    // Stream worker
+    alignas(64) RawSensors Sensors;
+    TsMocapFilter Filter;
+    TsMocapIdleDetector IdleDetector;
+    std::uint64_t PoseVersion = 0;
+    TsMocapLatency::DeviceClock Clock;
+    alignas(16) FVector4f PreviousTranslations[TsMocapFrame::BonesCount];
+    std::uint64_t PreviousMask = 0;
+    double PreviousSampleTime = 0.0;
+
+    StreamState()
+        : Api(MocapApi::Resolve())
+        , FrameBus(std::make_shared<TsMocapFrameBus>())
+    {
+    }
 
+    ~StreamState()
+    {
+        Stop();
+    }
+
+    void Start(UTsDevice* Device_);
+    void StartWorker();
+    void Stop();
+    void UpdateRequiredMask();
+    static void OnSkeleton(TsDeviceHandle* Handle, TsMocapSkeleton Skeleton, void* UserData);
+    static void OnSensors(TsDeviceHandle* Handle, TsMocapSensorSkeleton SensorSkeleton, void* UserData);
+
+    void Process()
+    {
+        const auto Offsets = std::atomic_load(&RotationOffsets);
+        const auto Params = std::atomic_load(&FilterParams);
+        if (Params.get() != Filter.GetParams())
+        {
+            Filter.SetParams(Params);
+        }
+        // Skeleton frames take the latest sensor readings, device clock is mapped with arrival of sensor frames it came with
+        while (auto Raw = RawSensorFrames.Front())
+        {
+            Sensors = *Raw;
+            Sensors.DeviceTime = Raw->DeviceTimestamp != 0 ? Clock.ToPlatformTime(Raw->DeviceTimestamp, Raw->ArrivalTime) : 0.0;
+            if (Sensors.DeviceTime > 0.0)
+            {
+                TsMocapLatency::Record(TsMocapLatency::EStage::Transport, Sensors.ArrivalTime - Sensors.DeviceTime);
+            }
+            RawSensorFrames.Pop();
+        }
+        const float GyroScale = CVarTsMocapGyroScale.GetValueOnAnyThread();
+        const float AccelerationScale = CVarTsMocapAccelerationScale.GetValueOnAnyThread();
+        const float IdleAngle = FMath::DegreesToRadians(CVarTsMocapIdleAngle.GetValueOnAnyThread());
+        const float IdleDistance = CVarTsMocapIdleDistance.GetValueOnAnyThread() / UnrealUnitsPerMeter;
+
+        while (auto Raw = RawFrames.Front())
+        {
+            auto& Frame = FrameBus->BeginWrite();
+            Frame.CaptureTime = Raw->CaptureTime;
+
+            // Skeleton frames carry no device time, their capture is estimated with transport delay of the sensor stream
+            Frame.DeviceTime = Sensors.DeviceTime > 0.0 ? Frame.CaptureTime - (Sensors.ArrivalTime - Sensors.DeviceTime) : 0.0;
+            Frame.BoneMask = Raw->Mask;
+            {
+                SCOPE_CYCLE_COUNTER(STAT_TsMocapConvert);
+                TsMocapConvert::ConvertBones(Raw->Bones, Raw->Mask, Offsets ? Offsets->data() : nullptr, Frame.Rotations, Frame.Translations);
+            }
+            {
+                SCOPE_CYCLE_COUNTER(STAT_TsMocapFilter);
+                Filter.Apply(Frame);
+            }
+            UpdateLinearVelocities(Frame);
+            {
+                SCOPE_CYCLE_COUNTER(STAT_TsMocapIdle);
+                const auto Version = IdleDetector.Update(Frame, IdleAngle, IdleDistance);
+                if (Version == PoseVersion)
+                {
+                    INC_DWORD_STAT(STAT_TsMocapIdleFrames);
+                }
+                Frame.PoseVersion = PoseVersion = Version;
+            }
+            Frame.SensorMask = Sensors.Mask & Raw->Mask;
+            Frame.SensorTime = Sensors.ArrivalTime;
+            for (auto Bits = Sensors.Mask; Bits != 0; Bits &= Bits - 1)
+            {
+                const auto Index = FMath::CountTrailingZeros64(Bits);
+                const auto& Gyro = Sensors.Gyro[Index];
+                const auto& Acceleration = Sensors.Acceleration[Index];
+                FVector3f AngularVelocity(Gyro.x, Gyro.z, -Gyro.y);
+                FVector3f LinearAcceleration(Acceleration.x, Acceleration.z, -Acceleration.y);
+                if (Offsets)
+                {
+                    // Frame rotations are sensor rotations followed by the offset, bring readings into the offset bone space
+                    const auto& Offset = (*Offsets)[Index];
+                    AngularVelocity = Offset.UnrotateVector(AngularVelocity);
+                    LinearAcceleration = Offset.UnrotateVector(LinearAcceleration);
+                }
+                Frame.AngularVelocities[Index] = FVector4f(AngularVelocity * GyroScale, 0.0f);
+                Frame.Accelerations[Index] = FVector4f(LinearAcceleration * AccelerationScale, 0.0f);
+            }
+            Frame.PublishTime = FPlatformTime::Seconds();
+            TsMocapLatency::Record(TsMocapLatency::EStage::Processing, Frame.PublishTime - Frame.CaptureTime);
+            FrameBus->EndWrite();
+            RawFrames.Pop();
+        }
+    }
+
+    // Bones present in the previous frame get velocity from their displacement, others are at rest
+    void UpdateLinearVelocities(TsMocapFrame& Frame)
+    {
+        const double SampleTime = Frame.DeviceTime > 0.0 ? Frame.DeviceTime : Frame.CaptureTime;
+        const float Interval = static_cast<float>(SampleTime - PreviousSampleTime);
+        const std::uint64_t Tracked = PreviousSampleTime > 0.0 && Interval > KINDA_SMALL_NUMBER ? Frame.BoneMask & PreviousMask : 0;
+        for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            const auto Index = FMath::CountTrailingZeros64(Bits);
+            const auto& T = Frame.Translations[Index];
+            const auto& Previous = PreviousTranslations[Index];
+            Frame.LinearVelocities[Index] = (Tracked & (1ull << Index)) != 0 ?
+                FVector4f(T.X - Previous.X, T.Y - Previous.Y, T.Z - Previous.Z, 0.0f) / Interval : FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+            PreviousTranslations[Index] = T;
+        }
+        PreviousMask = Frame.BoneMask;
+        PreviousSampleTime = SampleTime;
+    }
+};
+
+
+void UTsMocap::StreamState::Start(UTsDevice* Device_)
+{
+    DeviceId = Device_->GetDeviceId();
+    DeviceHandle = Device_->Handle;
+    auto Handle = static_cast<TsDeviceHandle*>(DeviceHandle);
+
+    StartWorker();
+    Api.SetSkeletonCallbackFn(Handle, &StreamState::OnSkeleton, this);
+    Api.SetSensorCallbackFn(Handle, &StreamState::OnSensors, this);
+    auto result = Api.StartStreamingFn(Handle);
+    if (result != 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("TsMocap: start sreaming error %d"), result);
+    }
+}
+
+void UTsMocap::StreamState::StartWorker()
+{
+    // Worker is created per streaming session to pick up current thread settings
+    Clock.Reset();
+    Monitor.Reset();
+    Sensors.Mask = 0;
+    Sensors.DeviceTime = 0.0;
+    PreviousMask = 0;
+    PreviousSampleTime = 0.0;
+    Worker = std::make_unique<TsStreamWorker>(TEXT("TsMocapWorker"), [this]() { Process(); });
+    Gate.Open();
+}
+
+void UTsMocap::StreamState::Stop()
+{
+    if (Worker == nullptr)
+    {
+        return;
+    }
+
+    // Device object may be collected before the stream, so callbacks are removed while provider keeps the handle open,
+    // disconnected device doesn't call back anymore
+    if (DeviceHandle != nullptr && ITeslasuitPlugin::IsAvailable() &&
+        ITeslasuitPlugin::Get().GetDeviceProvider().GetDeviceHandle(DeviceId) == DeviceHandle)
+    {
+        auto Handle = static_cast<TsDeviceHandle*>(DeviceHandle);
+        Api.SetSkeletonCallbackFn(Handle, nullptr, nullptr);
+        Api.SetSensorCallbackFn(Handle, nullptr, nullptr);
+        auto result = Api.StopStreamingFn(Handle);
+        if (result != 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("TsMocap: stop sreaming error %d"), result);
+        }
+    }
+    // Callbacks already inside may still wake the worker
+    Gate.Close();
+    Worker.reset();
+    DeviceHandle = nullptr;
+}
+
+void UTsMocap::StreamState::UpdateRequiredMask()
+{
+    // Without known consumers every bone may be read
+    std::uint64_t Required = RequiredBones.empty() ? TransformedMask : 0;
+    for (const auto& It : RequiredBones)
+    {
+        Required |= It.second;
+    }
+    Required &= TransformedMask;
+    RequiredMask.store(Required, std::memory_order_relaxed);
+    SET_DWORD_STAT(STAT_TsMocapBonesStreamed, FMath::CountBits(Required));
+}
 
 UTsMocap::UTsMocap()
     : UObject()
+    , Stream(std::make_shared<StreamState>())
 {
+    // Skeleton streams at about 100 Hz, a few late or lost frames per second are tolerated
+    HealthThresholds.MinRateHz = 50.0f;
+    HealthThresholds.MaxJitterMs = 20.0f;
+    HealthThresholds.MaxLostSamples = 5;
     Initialize();
     UE_LOG(LogTemp, Log, TEXT("TsMocap: constructed."));
 }
 
 void UTsMocap::Initialize()
 {
-    auto LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
-
-    StartMocapStreamingFn = reinterpret_cast<decltype(&ts_mocap_start_streaming)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_start_streaming")));
-    StopMocapStreamingFn = reinterpret_cast<decltype(&ts_mocap_stop_streaming)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_stop_streaming")));
-    SkeletonCalibrateFn = reinterpret_cast<decltype(&ts_mocap_skeleton_calibrate)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_skeleton_calibrate")));
-    SetSkeletonUpdateCallback = reinterpret_cast<decltype(&ts_mocap_set_skeleton_update_callback)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_set_skeleton_update_callback")));
-    SetMocapSensorUpdateCallack = reinterpret_cast<decltype(&ts_mocap_set_sensor_skeleton_update_callback)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_set_sensor_skeleton_update_callback")));
-    SkeletonGetBone = reinterpret_cast<decltype(&ts_mocap_skeleton_get_bone)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_skeleton_get_bone")));
-    SkeletonGetSensorBone = reinterpret_cast<decltype(&ts_mocap_sensor_skeleton_get_bone)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_mocap_sensor_skeletone_get_bone")));
-    
+    // Running shared stream keeps functions it was started with
+    if (!bMocapRunning)
+    {
+        Stream->Api = MocapApi::Resolve();
+    }
+
     Data.Empty();
     for (const auto BoneIndex : BonesToTransform)
     {
@@ -106,62 +442,164 @@ void UTsMocap::Initialize()
     }
 }
 
-void UTsMocap::SetCallbacks()
+void UTsMocap::StreamState::OnSkeleton(TsDeviceHandle* Handle, TsMocapSkeleton Skeleton, void* UserData)
+{
+    auto State = reinterpret_cast<StreamState*>(UserData);
+    if (State == nullptr)
+    {
+        return;
+    }
+    TsCallbackGate::Scope Scope(State->Gate);
+    if (!Scope)
+    {
+        return;
+    }
+    // Device timestamps come with the separate sensor stream, skeleton health is judged by arrival
+    const double ArrivalTime = FPlatformTime::Seconds();
+    State->Monitor.OnSample(ArrivalTime);
+
+    // Only copy raw bones here, worker converts and publishes them
+    auto Raw = State->RawFrames.BeginPush();
+    if (Raw == nullptr)
+    {
+        State->Monitor.OnDropped();
+        INC_DWORD_STAT(STAT_TsMocapRawDropped);
+        return;
+    }
+    Raw->CaptureTime = ArrivalTime;
+    Raw->Mask = State->RequiredMask.load(std::memory_order_relaxed);
+    for (auto Bits = Raw->Mask; Bits != 0; Bits &= Bits - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Bits);
+        State->Api.GetBoneFn(Skeleton, static_cast<TsBoneIndex>(Index), &Raw->Bones[Index]);
+    }
+    State->RawFrames.EndPush();
+    State->Worker->Wake();
+}
+
+// Sensor data carries device capture time and bone velocities, skeleton frames take the latest ones
+void UTsMocap::StreamState::OnSensors(TsDeviceHandle* Handle, TsMocapSensorSkeleton SensorSkeleton, void* UserData)
 {
-    SetSkeletonUpdateCallback(static_cast<TsDeviceHandle*>(ts_device->Handle), [](TsDeviceHandle* handle, TsMocapSkeleton Skeleton, void* UserData)
+    auto State = reinterpret_cast<StreamState*>(UserData);
+    if (State == nullptr || State->Api.GetSensorBoneFn == nullptr)
+    {
+        return;
+    }
+    TsCallbackGate::Scope Scope(State->Gate);
+    if (!Scope)
     {
-        auto Self = reinterpret_cast<UTsMocap*>(UserData);
-        std::lock_guard<std::mutex> ALock(Self->AccessMutex);
-        if (Self == nullptr || !Self->DeviceInitialized || !Self->bMocapRunning)
+        return;
+    }
+    auto Raw = State->RawSensorFrames.BeginPush();
+    if (Raw == nullptr)
+    {
+        return;
+    }
+    Raw->ArrivalTime = FPlatformTime::Seconds();
+    Raw->Mask = 0;
+    Raw->DeviceTimestamp = 0;
+    TsMocapSensor Sensor;
+
+    // Hips are always read as their timestamp maps device clock
+    const auto HipsIndex = static_cast<int32>(TsBoneIndex::TsBoneIndex_Hips);
+    const auto Required = State->RequiredMask.load(std::memory_order_relaxed) | (1ull << HipsIndex);
+    for (auto Bits = Required; Bits != 0; Bits &= Bits - 1)
+    {
+        const auto Index = FMath::CountTrailingZeros64(Bits);
+        if (State->Api.GetSensorBoneFn(SensorSkeleton, static_cast<TsBoneIndex>(Index), &Sensor) != 0)
         {
-            return;
+            continue;
         }
-        for (const auto BoneIndex : BonesToTransform)
+        Raw->Gyro[Index] = Sensor.gyro;
+        Raw->Acceleration[Index] = Sensor.linear_accel;
+        Raw->Mask |= 1ull << Index;
+        if (Index == HipsIndex)
         {
-            SkeletonGetBone(Skeleton, BoneIndex, &UpdateBone);
-            auto& Transform = Self->Data[static_cast<FTsBoneIndex>(BoneIndex)];
-            Transform.SetTranslation({ UpdateBone.position.x, UpdateBone.position.z, -UpdateBone.position.y });
-            Transform.SetRotation({ UpdateBone.rotation.x, UpdateBone.rotation.z, -UpdateBone.rotation.y, UpdateBone.rotation.w });
+            Raw->DeviceTimestamp = Sensor.timestamp;
         }
-    }, this);
+    }
+    State->RawSensorFrames.EndPush();
 }
 
 UTsMocap::~UTsMocap()
 {
-    std::lock_guard<std::mutex> lock(AccessMutex);
-    if (DeviceInitialized && ts_device->IsConnected())
+    // Stream stops when its last mocap object is gone
+    for (const auto& It : RequiredBones)
     {
-        DeviceInitialized = false;
-        StopMocap();
+        Stream->RequiredBones.erase(It.first);
     }
+    Stream->UpdateRequiredMask();
+    Stream.reset();
     Data.Empty();
 }
 
-void UTsMocap::StartMocap()
+std::shared_ptr<UTsMocap::StreamState> UTsMocap::AcquireStream(UTsDevice* Device)
 {
-    bMocapRunning = true;
-    auto result = StartMocapStreamingFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
-    if (result != 0)
+    // Device callback registration is exclusive, so a device has a single stream for all mocap objects
+    static std::map<void*, std::weak_ptr<StreamState>> Streams;
+    for (auto It = Streams.begin(); It != Streams.end();)
     {
-        UE_LOG(LogTemp, Log, TEXT("TsMocap: start sreaming error %d"), result);
+        It = It->second.expired() ? Streams.erase(It) : std::next(It);
+    }
+
+    auto& Weak = Streams[Device->Handle];
+    auto Shared = Weak.lock();
+    if (Shared == nullptr)
+    {
+        Shared = std::make_shared<StreamState>();
+        Shared->Start(Device);
+        Weak = Shared;
     }
+    return Shared;
 }
 
-void UTsMocap::StopMocap()
+void UTsMocap::Attach(std::shared_ptr<StreamState> NewStream)
 {
-    auto Handle = static_cast<TsDeviceHandle*>(ts_device->Handle);
-    SetSkeletonUpdateCallback(Handle, nullptr, nullptr);
-    auto result = StopMocapStreamingFn(Handle);
-    bMocapRunning = false;
-    if (result != 0) 
+    for (const auto& It : RequiredBones)
+    {
+        Stream->RequiredBones.erase(It.first);
+    }
+    Stream->UpdateRequiredMask();
+
+    // Detached mocap keeps a stream of its own, so settings and readers stay valid without device
+    Stream = NewStream != nullptr ? std::move(NewStream) : std::make_shared<StreamState>();
+    bMocapRunning = Stream->DeviceHandle != nullptr;
+    DataReader.reset();
+
+    // Settings of this mocap override the ones of shared stream
+    for (const auto& It : RequiredBones)
+    {
+        Stream->RequiredBones[It.first] = It.second;
+    }
+    Stream->UpdateRequiredMask();
+    if (bFilterSettingsSet)
+    {
+        SetFilterSettings(FilterSettings);
+    }
+    if (RotationOffsets.Num() > 0)
     {
-        UE_LOG(LogTemp, Log, TEXT("TsMocap: stop sreaming error %d"), result);
+        ApplyRotationOffsets();
     }
 }
 
+void UTsMocap::StartMocap()
+{
+    if (ts_device == nullptr || ts_device->Handle == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsMocap: failed to start streaming - no device."));
+        return;
+    }
+    Attach(AcquireStream(ts_device));
+}
+
+void UTsMocap::StopMocap()
+{
+    Attach(nullptr);
+}
+
 void UTsMocap::Calibrate()
 {
-    auto result = SkeletonCalibrateFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
+    auto result = Stream->Api.CalibrateFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
     if (result != 0) 
     {
         UE_LOG(LogTemp, Log, TEXT("TsMocap: calibrate skeleton error %d"), result);
@@ -170,18 +608,259 @@ void UTsMocap::Calibrate()
 
 void UTsMocap::GetMocapData(UTsMocap::MocapData& OutData) const
 {
-    std::lock_guard<std::mutex> lock(AccessMutex);
+    // Data holds every transformed bone, so the reader requires all of them
+    if (DataReader == nullptr)
+    {
+        DataReader = CreateFrameReader();
+        const_cast<UTsMocap*>(this)->SetRequiredBones(&DataReader, TransformedMask);
+    }
+    LastDataReadTime = FPlatformTime::Seconds();
+    DataReader->SkipToLatest();
+    if (auto Frame = DataReader->BeginRead())
+    {
+        // Frame may be overwritten while it is read, data is updated only from a consistent copy
+        auto Latest = Data;
+        for (auto& It : Latest)
+        {
+            const auto Index = static_cast<int32>(It.Key);
+            if (Frame->HasBone(Index))
+            {
+                It.Value = Frame->GetTransform(Index);
+            }
+        }
+        if (DataReader->EndRead())
+        {
+            Data = MoveTemp(Latest);
+        }
+    }
     OutData = Data;
 }
 
+void UTsMocap::SetBoneRotationOffset(FTsBoneIndex Bone, FRotator Offset)
+{
+    const auto Index = static_cast<int32>(Bone);
+    if (Index < 0 || Index >= TsMocapFrame::BonesCount)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsMocap: failed to set rotation offset - invalid bone index %d."), Index);
+        return;
+    }
+    RotationOffsets.Add(Bone, Offset);
+    ApplyRotationOffsets();
+}
+
+void UTsMocap::ClearBoneRotationOffsets()
+{
+    RotationOffsets.Empty();
+    ApplyRotationOffsets();
+}
+
+void UTsMocap::ApplyRotationOffsets()
+{
+    // Worker keeps using its copy of offsets until the new one is published
+    std::shared_ptr<RotationOffsetArray> Offsets;
+    if (RotationOffsets.Num() > 0)
+    {
+        Offsets = std::make_shared<RotationOffsetArray>();
+        Offsets->fill(FQuat4f::Identity);
+        for (const auto& It : RotationOffsets)
+        {
+            (*Offsets)[static_cast<int32>(It.Key)] = FQuat4f(FRotator3f(It.Value));
+        }
+    }
+    std::atomic_store(&Stream->RotationOffsets, std::shared_ptr<const RotationOffsetArray>(std::move(Offsets)));
+}
+
+void UTsMocap::SetRequiredBones(const void* Consumer, std::uint64_t Mask)
+{
+    if (Mask == 0)
+    {
+        RequiredBones.erase(Consumer);
+        Stream->RequiredBones.erase(Consumer);
+    }
+    else
+    {
+        RequiredBones[Consumer] = Mask;
+        Stream->RequiredBones[Consumer] = Mask;
+    }
+    Stream->UpdateRequiredMask();
+}
+
+void UTsMocap::SetFilterSettings(UTsMocapFilterSettings* Settings)
+{
+    FilterSettings = Settings;
+    bFilterSettingsSet = true;
+
+    // Worker restarts filtering when it picks up new parameters
+    std::atomic_store(&Stream->FilterParams, TsMocapFilterParams::Create(Settings));
+}
+
+void UTsMocap::Tick(float DeltaTime)
+{
+    if (LastDataReadTime > 0.0 && FPlatformTime::Seconds() - LastDataReadTime > DataReaderTimeout)
+    {
+        LastDataReadTime = 0.0;
+        DataReader.reset();
+        SetRequiredBones(&DataReader, 0);
+    }
+
+    // Monitor of shared stream is updated by whichever mocap object ticks first after its window
+    auto& Monitor = Stream->Monitor;
+    if (Monitor.Update(FPlatformTime::Seconds(), HealthThresholds))
+    {
+        const auto& Health = Monitor.GetHealth();
+        SET_FLOAT_STAT(STAT_TsMocapRate, Health.RateHz);
+        SET_FLOAT_STAT(STAT_TsMocapJitter, Health.JitterP99Ms);
+        SET_DWORD_STAT(STAT_TsMocapLost, Health.MissedSamples + Health.DroppedSamples);
+    }
+
+    const auto& Health = Monitor.GetHealth();
+    if (Health.bHealthy != bStreamHealthy)
+    {
+        bStreamHealthy = Health.bHealthy;
+        UE_LOG(LogTemp, Warning, TEXT("TsMocap: stream %s - %.1f Hz, jitter p99 %.2f ms, %d missed, %d dropped."),
+            Health.bHealthy ? TEXT("recovered") : TEXT("degraded"), Health.RateHz, Health.JitterP99Ms, Health.MissedSamples, Health.DroppedSamples);
+        OnStreamHealthChanged.Broadcast(Health);
+    }
+}
+
+bool UTsMocap::IsTickable() const
+{
+    return bMocapRunning && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UTsMocap::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTsMocap, STATGROUP_Tickables);
+}
+
+FTsStreamHealth UTsMocap::GetStreamHealth() const
+{
+    return Stream->Monitor.GetHealth();
+}
+
+std::unique_ptr<TsMocapFrameBus::Reader> UTsMocap::CreateFrameReader() const
+{
+    return std::make_unique<TsMocapFrameBus::Reader>(Stream->FrameBus);
+}
+
+const TsMocapFrameBus* UTsMocap::GetFrameBus() const
+{
+    return Stream->FrameBus.get();
+}
+
 void UTsMocap::SetTsDevice(UTsDevice* device)
 {
     ts_device = device;
     DeviceInitialized = true;
-    if (bMocapRunning)
-    {
-        StopMocap();
-    }
-    SetCallbacks();
     StartMocap();
 }
+
+/*!
+    \brief Streams simulated suits concurrently through the full callback path.
+
+    Each suit has its own callback thread calling the skeleton callback as fast as possible.
+    Bones of a suit carry its index, so frames mixing data of different suits are detected.
+*/
+struct TsMocapStreamBenchmark
+{
+    static TsStatusCode GetBone(const TsMocapSkeleton Skeleton, TsBoneIndex Index, TsMocapBone* Bone)
+    {
+        Bone->position = TsVec3f{ static_cast<float>(reinterpret_cast<std::uintptr_t>(Skeleton)), static_cast<float>(Index), 0.0f };
+        Bone->rotation = TsQuat{ 1.0f, 0.0f, 0.0f, 0.0f };
+        return 0;
+    }
+
+    static bool IsFrameOf(const TsMocapFrame& Frame, int32 Suit)
+    {
+        for (auto Bits = Frame.BoneMask; Bits != 0; Bits &= Bits - 1)
+        {
+            if (Frame.Translations[FMath::CountTrailingZeros64(Bits)].X != static_cast<float>(Suit))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void Run(const TArray<FString>& Args)
+    {
+        const int32 MaxSuits = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 4;
+        const double Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atod(*Args[1]), 0.1) : 1.0;
+
+        double SingleRate = 0.0;
+        for (int32 Suits = 1; Suits <= MaxSuits; ++Suits)
+        {
+            std::vector<std::shared_ptr<UTsMocap::StreamState>> Streams;
+            std::vector<std::unique_ptr<TsMocapFrameBus::Reader>> Readers;
+            for (int32 Suit = 0; Suit < Suits; ++Suit)
+            {
+                auto State = std::make_shared<UTsMocap::StreamState>();
+                State->Api.GetBoneFn = &TsMocapStreamBenchmark::GetBone;
+                State->StartWorker();
+                Readers.push_back(std::make_unique<TsMocapFrameBus::Reader>(State->FrameBus));
+                Streams.push_back(std::move(State));
+            }
+
+            std::atomic_bool bStop{ false };
+            TArray<TFuture<void>> Callbacks;
+            for (int32 Suit = 0; Suit < Suits; ++Suit)
+            {
+                auto State = Streams[Suit].get();
+                const auto Skeleton = reinterpret_cast<TsMocapSkeleton>(static_cast<std::uintptr_t>(Suit + 1));
+                Callbacks.Add(Async(EAsyncExecution::Thread, [State, Skeleton, &bStop]()
+                {
+                    while (!bStop.load(std::memory_order_relaxed))
+                    {
+                        UTsMocap::StreamState::OnSkeleton(nullptr, Skeleton, State);
+                    }
+                }));
+            }
+
+            // Consumers check frames while suits stream
+            int32 Checked = 0;
+            int32 Mismatched = 0;
+            const double End = FPlatformTime::Seconds() + Seconds;
+            while (FPlatformTime::Seconds() < End)
+            {
+                for (int32 Suit = 0; Suit < Suits; ++Suit)
+                {
+                    auto& Reader = *Readers[Suit];
+                    Reader.SkipToLatest();
+                    if (auto Frame = Reader.BeginRead())
+                    {
+                        const bool bValid = IsFrameOf(*Frame, Suit + 1);
+                        if (Reader.EndRead())
+                        {
+                            ++Checked;
+                            Mismatched += bValid ? 0 : 1;
+                        }
+                    }
+                }
+                FPlatformProcess::Sleep(0.001f);
+            }
+            bStop.store(true, std::memory_order_relaxed);
+            for (auto& Callback : Callbacks)
+            {
+                Callback.Wait();
+            }
+
+            std::uint64_t Published = 0;
+            std::uint64_t Dropped = 0;
+            for (auto& State : Streams)
+            {
+                State->Stop();
+                Published += State->FrameBus->GetPublished();
+                Dropped += State->RawFrames.GetDropped();
+            }
+            const double Rate = Published / Seconds;
+            SingleRate = Suits == 1 ? Rate : SingleRate;
+            UE_LOG(LogTemp, Display, TEXT("TsMocap: %d suits: %.0f frames/s per suit, scaling %.2f, %llu callbacks dropped, %d of %d frames mismatched."),
+                Suits, Rate / Suits, SingleRate > 0.0 ? Rate / (SingleRate * Suits) : 0.0, Dropped, Mismatched, Checked);
+        }
+    }
+};
+
+static FAutoConsoleCommand TsMocapBenchmarkStreamsCommand(
+    TEXT("Teslasuit.Mocap.BenchmarkStreams"),
+    TEXT("Streams simulated suits concurrently and reports per-suit throughput and scaling. Arguments: [MaxSuits=4] [Seconds=1]."),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&TsMocapStreamBenchmark::Run));
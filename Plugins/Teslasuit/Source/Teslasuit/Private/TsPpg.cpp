@@ -4,86 +4,155 @@
 #include "TsPpg.h"
 #include <Async/Async.h>
 #include "ITeslasuitPlugin.h"
+#include "TsStats.h"
+#include "Utils/TsCallbackGate.h"
+#include "Utils/TsSpscRing.h"
+#include "Utils/TsStreamMonitor.h"
+#include "Utils/TsStreamWorker.h"
 #include "ts_api/ts_device_api.h"
 #include "ts_api/ts_biometry_api.h"
-#include <vector>
 
+DECLARE_FLOAT_COUNTER_STAT(TEXT("PPG Rate (Hz)"), STAT_TsPpgRate, STATGROUP_Teslasuit);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PPG Samples Lost"), STAT_TsPpgLost, STATGROUP_Teslasuit);
 
-TsPpgData PpgData;
 
-decltype(&ts_ppg_raw_start_streaming) StartPPGStreamingFn;
-decltype(&ts_ppg_raw_stop_streaming) StopPPGStreamingFn;
-decltype(&ts_ppg_calibrate) CalibratePPGFn;
-decltype(&ts_ppg_set_update_callback) SetPpgUpdateCallback;
-decltype(&ts_ppg_get_heart_rate) GetHeartRateFn;
-decltype(&ts_ppg_get_oxygen_percent) GetOxygenPercentFn;
-decltype(&ts_ppg_get_number_of_nodes) GetPPGNumberOfNodesFn;
-decltype(&ts_ppg_get_node_indexes) GetPPGNodeIndexesFn;
+namespace
+{
+    const std::size_t MaxPpgNodes = 10;
+
+    /*!
+        \brief PPG functions of Teslasuit C API library.
+    */
+    struct PpgApi
+    {
+        decltype(&ts_ppg_raw_start_streaming) StartStreamingFn = nullptr;
+        decltype(&ts_ppg_raw_stop_streaming) StopStreamingFn = nullptr;
+        decltype(&ts_ppg_calibrate) CalibrateFn = nullptr;
+        decltype(&ts_ppg_set_update_callback) SetCallbackFn = nullptr;
+        decltype(&ts_ppg_get_heart_rate) GetHeartRateFn = nullptr;
+        decltype(&ts_ppg_get_oxygen_percent) GetOxygenPercentFn = nullptr;
+        decltype(&ts_ppg_get_number_of_nodes) GetNumberOfNodesFn = nullptr;
+        decltype(&ts_ppg_get_node_indexes) GetNodeIndexesFn = nullptr;
+
+        static PpgApi Resolve()
+        {
+            auto LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
+
+            PpgApi Api;
+            Api.StartStreamingFn = reinterpret_cast<decltype(&ts_ppg_raw_start_streaming)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_raw_start_streaming")));
+            Api.StopStreamingFn = reinterpret_cast<decltype(&ts_ppg_raw_stop_streaming)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_raw_stop_streaming")));
+            Api.CalibrateFn = reinterpret_cast<decltype(&ts_ppg_calibrate)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_calibrate")));
+            Api.SetCallbackFn = reinterpret_cast<decltype(&ts_ppg_set_update_callback)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_set_update_callback")));
+            Api.GetHeartRateFn = reinterpret_cast<decltype(&ts_ppg_get_heart_rate)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_heart_rate")));
+            Api.GetOxygenPercentFn = reinterpret_cast<decltype(&ts_ppg_get_oxygen_percent)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_oxygen_percent")));
+            Api.GetNumberOfNodesFn = reinterpret_cast<decltype(&ts_ppg_get_number_of_nodes)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_number_of_nodes")));
+            Api.GetNodeIndexesFn = reinterpret_cast<decltype(&ts_ppg_get_node_indexes)>(
+                FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_node_indexes")));
+            return Api;
+        }
+    };
+
+    /*!
+        \brief PPG readings copied from device callback.
+    */
+    struct RawPpg
+    {
+        uint32_t Heartrate = 0;
+        uint8_t Oxygen = 0;
+    };
+}
+
+/*!
+    \brief State shared between device callback and stream worker of a single device.
+
+    Fields are grouped by the thread writing them, each group on its own cache lines.
+*/
+struct alignas(64) UTsPpg::StreamState
+{
+    // Game thread
+    PpgApi Api;
+    std::unique_ptr<TsStreamWorker> Worker;
+    TsCallbackGate Gate;
 
+    // Device callback
+    alignas(64) TsSpscRing<RawPpg, 8> RawReadings;
+    TsStreamMonitor Monitor;
+
+    // Stream worker
+    alignas(64) std::atomic<int32> Heartrate{ 0 };
+    std::atomic<int32> OxygenPercent{ 0 };
+};
 
 UTsPpg::UTsPpg()
     : UObject()
+    , Stream(std::make_shared<StreamState>())
 {
+    // Readings arrive about once a second and gaps are found by arrival time only, so rate and jitter of a
+    // one second window aren't meaningful and a single late reading counts as lost, flag only longer silence
+    HealthThresholds.MaxLostSamples = 2;
     Initialize();
     UE_LOG(LogTemp, Log, TEXT("UTsPpg: constructed."));
 }
 
 void UTsPpg::Initialize()
 {
-    auto LibHandle = ITeslasuitPlugin::Get().GetLibHandle();
-
-    StartPPGStreamingFn = reinterpret_cast<decltype(&ts_ppg_raw_start_streaming)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_raw_start_streaming")));
-    StopPPGStreamingFn = reinterpret_cast<decltype(&ts_ppg_raw_stop_streaming)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_raw_stop_streaming")));
-    CalibratePPGFn = reinterpret_cast<decltype(&ts_ppg_calibrate)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_calibrate")));
-    SetPpgUpdateCallback = reinterpret_cast<decltype(&ts_ppg_set_update_callback)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_set_update_callback")));
-    GetHeartRateFn = reinterpret_cast<decltype(&ts_ppg_get_heart_rate)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_heart_rate")));
-    GetOxygenPercentFn = reinterpret_cast<decltype(&ts_ppg_get_oxygen_percent)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_oxygen_percent")));
-    GetPPGNumberOfNodesFn = reinterpret_cast<decltype(&ts_ppg_get_number_of_nodes)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_number_of_nodes")));
-    GetPPGNodeIndexesFn = reinterpret_cast<decltype(&ts_ppg_get_node_indexes)>(
-        FPlatformProcess::GetDllExport(LibHandle, *FString("ts_ppg_get_node_indexes")));
+    // Running stream keeps functions it was started with
+    if (!bPpgRunning)
+    {
+        Stream->Api = PpgApi::Resolve();
+    }
 }
 
 void UTsPpg::SetCallbacks()
 {
-    SetPpgUpdateCallback(static_cast<TsDeviceHandle*>(ts_device->Handle), [](TsDeviceHandle* Device, TsPpgData Ppg, void* UserData)
+    Stream->Api.SetCallbackFn(static_cast<TsDeviceHandle*>(ts_device->Handle), [](TsDeviceHandle* Device, TsPpgData Ppg, void* UserData)
     {
-        auto Self = reinterpret_cast<UTsPpg*>(UserData);
-        std::lock_guard<std::mutex> ALock(Self->AccessMutex);
-        if (Self == nullptr || !Self->DeviceInitialized || !Self->bPpgRunning)
+        auto State = reinterpret_cast<StreamState*>(UserData);
+        if (State == nullptr)
+        {
+            return;
+        }
+        TsCallbackGate::Scope Scope(State->Gate);
+        if (!Scope)
         {
             return;
         }
 
-        uint8_t count;
-        GetPPGNumberOfNodesFn(Ppg, &count);
-
-        std::vector<uint8_t> nodes(10);
-        GetPPGNodeIndexesFn(Ppg, nodes.data(), nodes.size());
+        State->Monitor.OnSample(FPlatformTime::Seconds());
 
-        if (count > 0)
+        // PPG data is valid only during callback, copy readings and let worker publish them
+        uint8_t count = 0;
+        State->Api.GetNumberOfNodesFn(Ppg, &count);
+        if (count == 0)
         {
-            uint32_t heartrate;
-            GetHeartRateFn(Ppg, nodes[0], &heartrate);
+            return;
+        }
 
-            uint8_t oxygen;
-            GetOxygenPercentFn(Ppg, nodes[0], &oxygen);
+        uint8_t nodes[MaxPpgNodes] = {};
+        State->Api.GetNodeIndexesFn(Ppg, nodes, MaxPpgNodes);
 
-            Self->Heartrate = heartrate;
-            Self->OxygenPercent = oxygen;
+        auto Raw = State->RawReadings.BeginPush();
+        if (Raw == nullptr)
+        {
+            State->Monitor.OnDropped();
+            return;
         }
-    }, this);
+        State->Api.GetHeartRateFn(Ppg, nodes[0], &Raw->Heartrate);
+        State->Api.GetOxygenPercentFn(Ppg, nodes[0], &Raw->Oxygen);
+        State->RawReadings.EndPush();
+        State->Worker->Wake();
+    }, Stream.get());
 }
 
 UTsPpg::~UTsPpg()
 {
-    std::lock_guard<std::mutex> lock(AccessMutex);
     if (DeviceInitialized && ts_device->Handle)
     {
         DeviceInitialized = false;
@@ -93,8 +162,21 @@ UTsPpg::~UTsPpg()
 
 void UTsPpg::StartPpg()
 {
+    // Readings are applied in order, stream keeps the latest one for game thread
+    auto State = Stream.get();
+    State->Monitor.Reset();
+    State->Worker = std::make_unique<TsStreamWorker>(TEXT("TsPpgWorker"), [State]()
+    {
+        while (auto Raw = State->RawReadings.Front())
+        {
+            State->Heartrate.store(static_cast<int32>(Raw->Heartrate), std::memory_order_relaxed);
+            State->OxygenPercent.store(Raw->Oxygen, std::memory_order_relaxed);
+            State->RawReadings.Pop();
+        }
+    });
+    State->Gate.Open();
     bPpgRunning = true;
-    auto result = StartPPGStreamingFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
+    auto result = State->Api.StartStreamingFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
     if (result != 0)
     {
         UE_LOG(LogTemp, Log, TEXT("UTsPpg: start sreaming error %d"), result);
@@ -104,9 +186,12 @@ void UTsPpg::StartPpg()
 void UTsPpg::StopPpg()
 {
     auto Handle = static_cast<TsDeviceHandle*>(ts_device->Handle);
-    SetPpgUpdateCallback(Handle, nullptr, nullptr);
-    auto result = StopPPGStreamingFn(Handle);
+    Stream->Api.SetCallbackFn(Handle, nullptr, nullptr);
+    auto result = Stream->Api.StopStreamingFn(Handle);
     bPpgRunning = false;
+    // Callbacks already inside may still wake the worker
+    Stream->Gate.Close();
+    Stream->Worker.reset();
     if (result != 0) 
     {
         UE_LOG(LogTemp, Log, TEXT("UTsPpg: stop sreaming error %d"), result);
@@ -115,21 +200,61 @@ void UTsPpg::StopPpg()
 
 void UTsPpg::Calibrate()
 {
-    auto result = CalibratePPGFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
+    auto result = Stream->Api.CalibrateFn(static_cast<TsDeviceHandle*>(ts_device->Handle));
     if (result != 0)
     {
         UE_LOG(LogTemp, Log, TEXT("UTsPpg: calibrate error %d"), result);
     }
 }
 
+void UTsPpg::Tick(float DeltaTime)
+{
+    // Properties are only written on game thread
+    Heartrate = Stream->Heartrate.load(std::memory_order_relaxed);
+    OxygenPercent = Stream->OxygenPercent.load(std::memory_order_relaxed);
+
+    auto& Monitor = Stream->Monitor;
+    const bool bWasHealthy = Monitor.GetHealth().bHealthy;
+    if (!Monitor.Update(FPlatformTime::Seconds(), HealthThresholds))
+    {
+        return;
+    }
+
+    const auto& Health = Monitor.GetHealth();
+    SET_FLOAT_STAT(STAT_TsPpgRate, Health.RateHz);
+    SET_DWORD_STAT(STAT_TsPpgLost, Health.MissedSamples + Health.DroppedSamples);
+    if (Health.bHealthy != bWasHealthy)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UTsPpg: stream %s - %.1f Hz, jitter p99 %.2f ms, %d missed, %d dropped."),
+            Health.bHealthy ? TEXT("recovered") : TEXT("degraded"), Health.RateHz, Health.JitterP99Ms, Health.MissedSamples, Health.DroppedSamples);
+        OnStreamHealthChanged.Broadcast(Health);
+    }
+}
+
+bool UTsPpg::IsTickable() const
+{
+    return bPpgRunning && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UTsPpg::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTsPpg, STATGROUP_Tickables);
+}
+
+FTsStreamHealth UTsPpg::GetStreamHealth() const
+{
+    return Stream->Monitor.GetHealth();
+}
+
 void UTsPpg::SetTsDevice(UTsDevice* device)
 {
-    ts_device = device;
-    DeviceInitialized = true;
+    // Stream of the previous device is stopped with its own handle before switching
     if (bPpgRunning)
     {
         StopPpg();
     }
+    ts_device = device;
+    DeviceInitialized = true;
     SetCallbacks();
     StartPpg();
 }
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+/*!
+    \brief Lets device callbacks into stream state only while the stream is running.
+
+    Callbacks enter the gate before touching the state, so closing it waits for callbacks
+    which are already inside and the state can be destroyed right after #Close returns.
+*/
+class TsCallbackGate
+{
+public:
+    /*!
+        \brief Keeps callback inside the gate for its lifetime, check it before using the state.
+    */
+    class Scope
+    {
+    public:
+        explicit Scope(TsCallbackGate& Gate_)
+            : Gate(Gate_)
+            , bEntered(Gate_.Enter())
+        {
+        }
+
+        ~Scope()
+        {
+            if (bEntered)
+            {
+                Gate.Leave();
+            }
+        }
+
+        explicit operator bool() const { return bEntered; }
+
+    private:
+        TsCallbackGate& Gate;
+        const bool bEntered;
+    };
+
+public:
+    /*!
+        \brief Lets callbacks in.
+    */
+    void Open()
+    {
+        bOpen.store(true);
+    }
+
+    /*!
+        \brief Stops letting callbacks in and waits for the ones inside to leave.
+    */
+    void Close()
+    {
+        bOpen.store(false);
+        while (InFlight.load() != 0)
+        {
+            FPlatformProcess::YieldThread();
+        }
+    }
+
+private:
+    bool Enter()
+    {
+        // Both sides use sequentially consistent order, so Close either sees the counter or the callback sees the gate closed
+        InFlight.fetch_add(1);
+        if (bOpen.load())
+        {
+            return true;
+        }
+        Leave();
+        return false;
+    }
+
+    void Leave()
+    {
+        InFlight.fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+    std::atomic_bool bOpen{ false };
+    std::atomic<int32> InFlight{ 0 };
+};
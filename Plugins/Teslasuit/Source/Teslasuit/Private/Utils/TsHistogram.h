@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CoreMinimal.h"
+
+/*!
+    \brief Fixed bucket histogram which can be filled from any thread.
+
+    Values are counted into equal buckets of BucketWidth, values past the last bucket
+    are counted in the last one. Adding a value costs a few relaxed atomics.
+*/
+template <std::size_t BucketsCount>
+class TsHistogram
+{
+public:
+    explicit TsHistogram(double BucketWidth_)
+        : BucketWidth(BucketWidth_)
+    {
+        Reset();
+    }
+
+    void Add(double Value)
+    {
+        const double Bucket = FMath::Max(Value, 0.0) / BucketWidth;
+        const auto Index = Bucket < BucketsCount ? static_cast<std::size_t>(Bucket) : BucketsCount - 1;
+        Buckets[Index].fetch_add(1, std::memory_order_relaxed);
+        Count.fetch_add(1, std::memory_order_relaxed);
+
+        // Max is updated rarely, CAS loop settles quickly
+        auto Current = Max.load(std::memory_order_relaxed);
+        while (Value > Current && !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /*!
+        \brief Returns upper bound of the bucket containing given fraction [0..1] of values.
+    */
+    double GetPercentile(double Fraction) const
+    {
+        const auto Total = Count.load(std::memory_order_relaxed);
+        if (Total == 0)
+        {
+            return 0.0;
+        }
+        const auto Target = static_cast<std::uint64_t>(FMath::CeilToDouble(FMath::Clamp(Fraction, 0.0, 1.0) * Total));
+        std::uint64_t Accumulated = 0;
+        for (std::size_t Index = 0; Index < BucketsCount; ++Index)
+        {
+            Accumulated += Buckets[Index].load(std::memory_order_relaxed);
+            if (Accumulated >= Target)
+            {
+                return FMath::Min((Index + 1) * BucketWidth, GetMax());
+            }
+        }
+        return GetMax();
+    }
+
+    std::uint64_t GetCount() const { return Count.load(std::memory_order_relaxed); }
+    double GetMax() const { return Max.load(std::memory_order_relaxed); }
+
+    void Reset()
+    {
+        for (auto& Bucket : Buckets)
+        {
+            Bucket.store(0, std::memory_order_relaxed);
+        }
+        Count.store(0, std::memory_order_relaxed);
+        Max.store(0.0, std::memory_order_relaxed);
+    }
+
+private:
+    const double BucketWidth;
+    std::atomic<std::uint64_t> Buckets[BucketsCount];
+    std::atomic<std::uint64_t> Count;
+    std::atomic<double> Max;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CoreMinimal.h"
+
+/*!
+    \brief Fixed size single producer, single consumer ring.
+
+    Items are written and read in place, so pushing costs a copy of the item and two atomics.
+    Producer never waits: when ring is full the new item is dropped and counted.
+*/
+template <typename T, std::uint64_t Capacity>
+class TsSpscRing
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "TsSpscRing capacity must be a power of two.");
+
+public:
+    /*!
+        \brief Returns slot to be filled by producer or nullptr if ring is full.
+    */
+    T* BeginPush()
+    {
+        const auto Index = Head.load(std::memory_order_relaxed);
+        if (Index - Tail.load(std::memory_order_acquire) >= Capacity)
+        {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &Items[Index & (Capacity - 1)];
+    }
+
+    /*!
+        \brief Publishes slot filled after #BeginPush.
+    */
+    void EndPush()
+    {
+        Head.store(Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /*!
+        \brief Returns oldest item or nullptr if ring is empty.
+    */
+    T* Front()
+    {
+        const auto Index = Tail.load(std::memory_order_relaxed);
+        if (Index == Head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &Items[Index & (Capacity - 1)];
+    }
+
+    /*!
+        \brief Releases item returned by #Front.
+    */
+    void Pop()
+    {
+        Tail.store(Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /*!
+        \brief Number of items dropped because ring was full.
+    */
+    std::uint64_t GetDropped() const
+    {
+        return Dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> Head{ 0 };
+    alignas(64) std::atomic<std::uint64_t> Tail{ 0 };
+    alignas(64) std::atomic<std::uint64_t> Dropped{ 0 };
+    T Items[Capacity];
+};
@@ -0,0 +1,111 @@
+#include "Utils/TsStreamMonitor.h"
+
+namespace
+{
+    const double WindowSeconds = 1.0;
+    // Interval longer than this many average intervals is a gap
+    const double GapFactor = 1.8;
+    // Smoothing of average interval, follows rate changes within about a hundred samples
+    const double AverageWeight = 0.01;
+}
+
+TsStreamMonitor::TsStreamMonitor()
+    : Jitter(0.25)
+{
+}
+
+void TsStreamMonitor::Reset()
+{
+    LastArrivalTime = 0.0;
+    LastDeviceTimestamp = 0;
+    AverageInterval = 0.0;
+    AverageDelta = 0.0;
+    Jitter.Reset();
+    Samples.store(0, std::memory_order_relaxed);
+    Gaps.store(0, std::memory_order_relaxed);
+    Missed.store(0, std::memory_order_relaxed);
+    Dropped.store(0, std::memory_order_relaxed);
+
+    WindowStart = 0.0;
+    WindowSamples = 0;
+    WindowGaps = 0;
+    WindowMissed = 0;
+    WindowDropped = 0;
+    Health = FTsStreamHealth();
+}
+
+void TsStreamMonitor::OnSample(double ArrivalTime, std::uint64_t DeviceTimestamp)
+{
+    Samples.fetch_add(1, std::memory_order_relaxed);
+    if (LastArrivalTime > 0.0)
+    {
+        const double Interval = ArrivalTime - LastArrivalTime;
+        Jitter.Add(AverageInterval > 0.0 ? FMath::Abs(Interval - AverageInterval) * 1000.0 : 0.0);
+
+        // Device timestamps show lost samples even when arrival is bursty
+        const bool bDeviceTime = DeviceTimestamp != 0 && LastDeviceTimestamp != 0 && DeviceTimestamp > LastDeviceTimestamp;
+        const double Delta = bDeviceTime ? static_cast<double>(DeviceTimestamp - LastDeviceTimestamp) : Interval;
+        double& Average = bDeviceTime ? AverageDelta : AverageInterval;
+        if (Average > 0.0 && Delta > Average * GapFactor)
+        {
+            Gaps.fetch_add(1, std::memory_order_relaxed);
+            Missed.fetch_add(static_cast<std::uint64_t>(FMath::RoundToDouble(Delta / Average)) - 1, std::memory_order_relaxed);
+        }
+        else
+        {
+            Average = Average > 0.0 ? Average + (Delta - Average) * AverageWeight : Delta;
+        }
+        if (bDeviceTime)
+        {
+            AverageInterval = AverageInterval > 0.0 ? AverageInterval + (Interval - AverageInterval) * AverageWeight : Interval;
+        }
+    }
+    LastArrivalTime = ArrivalTime;
+    LastDeviceTimestamp = DeviceTimestamp;
+}
+
+void TsStreamMonitor::OnDropped()
+{
+    Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TsStreamMonitor::Update(double Now, const FTsStreamHealthThresholds& Thresholds)
+{
+    if (WindowStart <= 0.0)
+    {
+        WindowStart = Now;
+        return false;
+    }
+    const double Elapsed = Now - WindowStart;
+    if (Elapsed < WindowSeconds)
+    {
+        return false;
+    }
+
+    const auto TotalSamples = Samples.load(std::memory_order_relaxed);
+    const auto TotalGaps = Gaps.load(std::memory_order_relaxed);
+    const auto TotalMissed = Missed.load(std::memory_order_relaxed);
+    const auto TotalDropped = Dropped.load(std::memory_order_relaxed);
+
+    Health.RateHz = static_cast<float>((TotalSamples - WindowSamples) / Elapsed);
+    Health.JitterP50Ms = static_cast<float>(Jitter.GetPercentile(0.5));
+    Health.JitterP90Ms = static_cast<float>(Jitter.GetPercentile(0.9));
+    Health.JitterP99Ms = static_cast<float>(Jitter.GetPercentile(0.99));
+    Health.Gaps = static_cast<int32>(TotalGaps - WindowGaps);
+    Health.MissedSamples = static_cast<int32>(TotalMissed - WindowMissed);
+    Health.DroppedSamples = static_cast<int32>(TotalDropped - WindowDropped);
+
+    const int32 Lost = Health.MissedSamples + Health.DroppedSamples;
+    Health.bHealthy = (Thresholds.MinRateHz < 0.0f || Health.RateHz >= Thresholds.MinRateHz)
+        && (Thresholds.MaxJitterMs < 0.0f || Health.JitterP99Ms <= Thresholds.MaxJitterMs)
+        && (Thresholds.MaxLostSamples < 0 || Lost <= Thresholds.MaxLostSamples);
+
+    // Jitter percentiles describe the window only
+    Jitter.Reset();
+    WindowStart = Now;
+    WindowSamples = TotalSamples;
+    WindowGaps = TotalGaps;
+    WindowMissed = TotalMissed;
+    WindowDropped = TotalDropped;
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "TsStreamHealth.h"
+#include "Utils/TsHistogram.h"
+
+/*!
+    \brief Lock-free health tracking of a device data stream.
+
+    Samples are reported from the device callback thread, health is evaluated on the game thread
+    once per window. Gaps are detected from discontinuities of device timestamps when provided,
+    otherwise from arrival times.
+*/
+class TsStreamMonitor
+{
+public:
+    TsStreamMonitor();
+
+    /*!
+        \brief Forgets stream history, must be called while no samples are reported.
+    */
+    void Reset();
+
+    /*!
+        \brief Reports received sample, called from device callback thread.
+    */
+    void OnSample(double ArrivalTime, std::uint64_t DeviceTimestamp = 0);
+
+    /*!
+        \brief Reports sample dropped by plugin, called from device callback thread.
+    */
+    void OnDropped();
+
+    /*!
+        \brief Evaluates health once per window, returns true if health was updated.
+    */
+    bool Update(double Now, const FTsStreamHealthThresholds& Thresholds);
+
+    /*!
+        \brief Health of the last complete window.
+    */
+    const FTsStreamHealth& GetHealth() const { return Health; }
+
+private:
+    // Callback thread state
+    double LastArrivalTime = 0.0;
+    std::uint64_t LastDeviceTimestamp = 0;
+    double AverageInterval = 0.0;
+    double AverageDelta = 0.0;
+
+    TsHistogram<200> Jitter;
+    std::atomic<std::uint64_t> Samples{ 0 };
+    std::atomic<std::uint64_t> Gaps{ 0 };
+    std::atomic<std::uint64_t> Missed{ 0 };
+    std::atomic<std::uint64_t> Dropped{ 0 };
+
+    // Game thread state, kept off cache lines written by callback thread
+    alignas(64) double WindowStart = 0.0;
+    std::uint64_t WindowSamples = 0;
+    std::uint64_t WindowGaps = 0;
+    std::uint64_t WindowMissed = 0;
+    std::uint64_t WindowDropped = 0;
+    FTsStreamHealth Health;
+};
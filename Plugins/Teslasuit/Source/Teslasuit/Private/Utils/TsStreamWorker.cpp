@@ -0,0 +1,85 @@
+#include "Utils/TsStreamWorker.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+
+static TAutoConsoleVariable<int32> CVarTsStreamWorkerPriority(
+    TEXT("Teslasuit.Stream.WorkerPriority"),
+    1,
+    TEXT("Priority of device stream workers: -2 lowest, -1 below normal, 0 normal, 1 above normal, 2 highest, 3 time critical.\n")
+    TEXT("Applied when streaming starts."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTsStreamWorkerAffinity(
+    TEXT("Teslasuit.Stream.WorkerAffinity"),
+    0,
+    TEXT("Core mask of device stream workers, 0 lets the OS choose. Applied when streaming starts."),
+    ECVF_Default);
+
+namespace
+{
+    EThreadPriority GetWorkerPriority()
+    {
+        switch (CVarTsStreamWorkerPriority.GetValueOnAnyThread())
+        {
+        case -2: return TPri_Lowest;
+        case -1: return TPri_BelowNormal;
+        case 0: return TPri_Normal;
+        case 2: return TPri_Highest;
+        case 3: return TPri_TimeCritical;
+        default: return TPri_AboveNormal;
+        }
+    }
+
+    uint64 GetWorkerAffinity()
+    {
+        const auto Mask = static_cast<uint32>(CVarTsStreamWorkerAffinity.GetValueOnAnyThread());
+        return Mask != 0 ? static_cast<uint64>(Mask) : FPlatformAffinity::GetNoAffinityMask();
+    }
+}
+
+TsStreamWorker::TsStreamWorker(const TCHAR* Name, Process&& Fn_, uint32 WaitMs_)
+    : Fn(std::move(Fn_))
+    , WaitMs(WaitMs_)
+    , WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+    Thread = FRunnableThread::Create(this, Name, 0, GetWorkerPriority(), GetWorkerAffinity());
+    if (Thread == nullptr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TsStreamWorker: failed to create %s thread."), Name);
+    }
+}
+
+TsStreamWorker::~TsStreamWorker()
+{
+    if (Thread != nullptr)
+    {
+        // Kill calls Stop and waits for Run to return
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+void TsStreamWorker::Wake()
+{
+    WakeEvent->Trigger();
+}
+
+uint32 TsStreamWorker::Run()
+{
+    while (!bStopping.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(WaitMs);
+        Fn();
+    }
+    return 0;
+}
+
+void TsStreamWorker::Stop()
+{
+    bStopping.store(true, std::memory_order_release);
+    WakeEvent->Trigger();
+}
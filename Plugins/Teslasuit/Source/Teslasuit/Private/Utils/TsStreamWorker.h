@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class FRunnableThread;
+
+/*!
+    \brief Plugin owned thread which processes data received from device streams.
+
+    Device callbacks only copy raw data into a ring and wake the worker,
+    conversion and fan-out run on the worker, so processing cost doesn't delay the device SDK.
+    Thread priority and affinity are taken from "Teslasuit.Stream.WorkerPriority"
+    and "Teslasuit.Stream.WorkerAffinity" console variables when the worker starts.
+*/
+class TsStreamWorker : public FRunnable
+{
+public:
+    using Process = std::function<void()>;
+
+public:
+    /*!
+        \brief Starts the worker, WaitMs limits time between processing runs for sources that can't wake it.
+    */
+    TsStreamWorker(const TCHAR* Name, Process&& Fn_, uint32 WaitMs_ = MAX_uint32);
+    ~TsStreamWorker() override;
+
+    /*!
+        \brief Schedules processing, can be called from any thread.
+    */
+    void Wake();
+
+    // FRunnable
+    uint32 Run() override;
+    void Stop() override;
+
+private:
+    Process Fn;
+    uint32 WaitMs = MAX_uint32;
+    FEvent* WakeEvent = nullptr;
+    std::atomic_bool bStopping{ false };
+    FRunnableThread* Thread = nullptr;
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TsMocap.h"
+#include "TsAudioHapticComponent.generated.h"
+
+class USoundSubmix;
+class UTsHapticImpactComponent;
+class FTsAudioHapticListener;
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Frequency band of audio converted to haptic.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsAudioHapticBand
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Upper frequency of the band, lower frequency is the cutoff of the previous band.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (ClampMin = "10.0", Units = "Hz"))
+    float CutoffHz = 100.0f;
+
+    /*!
+        \brief Scale from band RMS to impact intensity.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float Gain = 4.0f;
+
+    /*!
+        \brief Band RMS below which no impact is produced.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float Threshold = 0.01f;
+
+    /*!
+        \brief Bones which receive the band impact.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic")
+    TArray<FTsBoneIndex> Bones;
+};
+
+/*!
+    \brief Converts audio of a submix into haptic impacts.
+
+    Component listens to submix output on the audio render thread and splits it into
+    #BandsCount frequency bands with one-pole low-pass filters evaluated together in one SIMD register.
+    Audio thread only accumulates band energy into atomics, it doesn't allocate or lock.
+    Submix listener is a shared object apart from the component, unregistering it is asynchronous,
+    so the last reference is released on the audio render thread after the listener is removed.
+    Game thread converts band RMS into impacts at fixed ControlRate and passes them
+    to #UTsHapticImpactComponent of the owner, which sends only changed channels to device.
+*/
+UCLASS(ClassGroup = Teslasuit, Category = "Teslasuit", meta = (BlueprintSpawnableComponent))
+class TESLASUIT_API UTsAudioHapticComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 BandsCount = 4;
+
+    UTsAudioHapticComponent();
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /*!
+        \brief Returns last RMS of the band.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    float GetBandLevel(int32 Band) const;
+
+public:
+    /*!
+        \brief Submix to analyze, main submix if not set.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic")
+    USoundSubmix* Submix = nullptr;
+
+    /*!
+        \brief Impact component to drive, first impact component of the owner if not set.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    UTsHapticImpactComponent* ImpactComponent = nullptr;
+
+    /*!
+        \brief Frequency bands from low to high.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic")
+    FTsAudioHapticBand Bands[4];
+
+    /*!
+        \brief Rate of impact updates per second.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "1.0", ClampMax = "200.0"))
+    float ControlRate = 50.0f;
+
+private:
+    // Registered submix listener, audio thread may hold it a bit longer than the component
+    TSharedPtr<FTsAudioHapticListener, ESPMode::ThreadSafe> Listener;
+
+    // Game thread state
+    float Levels[BandsCount] = {};
+    float ControlTime = 0.0f;
+};
+
+/**@}*/
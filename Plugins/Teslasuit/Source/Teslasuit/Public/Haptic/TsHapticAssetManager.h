@@ -1,7 +1,11 @@
 #pragma once
 #include <set>
 #include <map>
+#include <string>
+#include <vector>
+#include <functional>
 #include "TsAsset.h"
+#include "Haptic/TsHapticVoiceManager.h"
 
 /**
 * \defgroup haptic Haptic Module
@@ -27,10 +31,22 @@ In order to release resources:
 	- Remove all created playables with #RemoveAllPlayables method
 	- Unload all assets with #UnloadAllAssets method
 
-#UTsHapticPlayer is automatically manages all things listed above.
+#UTsHapticPlayer is automatically manages all things listed above, its playables are taken from #TsHapticPlayablePool.
 */
 class TESLASUIT_API TsHapticAssetManager
 {
+public:
+    /*!
+        \brief Result of playing asset on multiple devices.
+    */
+    struct BroadcastResult
+    {
+        int32 Played = 0;
+        double SkewMs = 0.0;
+    };
+
+    using UnloadCallback = std::function<void(void* AssetHandle)>;
+
 public:
 	TsHapticAssetManager();
 	~TsHapticAssetManager();
@@ -40,6 +56,9 @@ public:
 	/*!
 		\brief Loads haptic asset and returns handle to it.
 
+		Assets with equal content hash share one loaded handle,
+		it is unloaded when all of them are unloaded.
+
 		\return void*
 	*/
 	void* LoadAsset(const UTsAsset& Asset);
@@ -49,6 +68,17 @@ public:
 	*/
 	void UnloadAsset(const UTsAsset& Asset);
 
+	/*!
+		\brief Loads raw asset data to validate it and read its type, asset is unloaded right after.
+
+		Returns ETsAssetType::Undefined for invalid data.
+		Duration can be measured only with a playable, so OutDuration is set if a device is connected, 0 otherwise.
+		Calls C API, so it must not be called from several threads at once.
+
+		\return ETsAssetType
+	*/
+	ETsAssetType InspectAsset(const uint8* Data, std::size_t Size, float* OutDuration = nullptr);
+
 	/*!
 		\brief Creates playable from asset handle for device with specific haptic configuration.
 
@@ -63,6 +93,29 @@ public:
 	*/
 	void RemovePlayable(void* DeviceHandle, std::uint64_t PlayableId);
 
+	/*!
+		\brief Plays asset on multiple devices at once.
+
+		Playables are acquired from #TsHapticPlayablePool once per device and asset and cached for next broadcasts.
+		Each device admits the broadcast through #TsHapticVoiceManager, so voice limits apply,
+		play commands of admitted devices are dispatched in parallel.
+		Returns number of devices started and skew between the first and the last play command returning.
+
+		\return BroadcastResult
+	*/
+	BroadcastResult PlayOnDevices(const std::vector<void*>& DeviceHandles, const UTsAsset& Asset, const FTsHapticVoiceParams& Params = FTsHapticVoiceParams());
+
+	/*!
+		\brief Subscribes on asset unloading, callback is called before the asset handle becomes invalid.
+	*/
+	void SubscribeOnUnload(intptr_t SubscriberId, const UnloadCallback& Cb);
+	void UnSubscribeOnUnload(intptr_t SubscriberId);
+
+	/*!
+		\brief Forgets playables of disconnected device.
+	*/
+	void RemoveDevice(void* DeviceHandle);
+
 	/*!
 		\brief Removes all created playables for all devices.
 	*/
@@ -81,12 +134,27 @@ public:
 	void SetLibHandle(void* Handle);
 
 private:
+	struct LoadedAsset
+	{
+		void* Handle = nullptr;
+		/*! Unique ids of assets which loaded the handle, one entry per #LoadAsset call. */
+		std::multiset<uint32> Users;
+		/*! Data handle was loaded from, C API may reference it while the handle is loaded. */
+		TArray<uint8> Payload;
+	};
+
+	static std::string GetAssetKey(const UTsAsset& Asset);
 	void UnloadAsset(void* AssetHandle);
+	float MeasureDuration(void* AssetHandle);
 
 private:
 	void* LibHandle = nullptr;
-	std::map<uint32, void*> AssetHandles;
+	std::map<std::string, LoadedAsset> AssetHandles;
 	std::set<void*> UsedDevices;
+	std::map<std::pair<void*, uint32>, std::uint64_t> BroadcastPlayables;
+	/*! Assets loaded by #PlayOnDevices, each of them holds one load until the asset is unloaded. */
+	std::set<uint32> BroadcastAssets;
+	std::map<intptr_t, UnloadCallback> UnloadCallbacks;
 };
 
 /**@}*/
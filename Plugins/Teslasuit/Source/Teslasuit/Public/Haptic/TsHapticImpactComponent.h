@@ -0,0 +1,149 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TsAsset.h"
+#include "TsDevice.h"
+#include "TsMocap.h"
+#include "Haptic/TsHapticMapping.h"
+#include "TsHapticImpactComponent.generated.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief How impacts received by a bone during a frame are combined.
+*/
+UENUM(BlueprintType)
+enum class ETsImpactReduction : uint8
+{
+    /*! Strongest contact of the frame wins. */
+    Max = 0,
+    /*! Contacts of the frame are summed and clamped to 1. */
+    Sum = 1,
+    /*! Strongest contact wins and the impact fades out with DecayRate afterwards. */
+    Decay = 2
+};
+
+/*!
+    \brief Converts physics contacts into continuous haptic material impacts.
+
+    Component plays haptic material asset on device and drives its channel impacts
+    with ts_haptic_set_material_channel_impact.
+    Contacts are gathered from hits of owner's primitive components and from #AddImpact calls,
+    mapped to bones, reduced per bone and flushed once per tick on haptic thread.
+    Only bones which impact has changed are sent to device, so the cost scales with
+    changed channels instead of raw contacts.
+*/
+UCLASS(ClassGroup = Teslasuit, Category = "Teslasuit", meta = (BlueprintSpawnableComponent))
+class TESLASUIT_API UTsHapticImpactComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UTsHapticImpactComponent();
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /*!
+        \brief Set device to play impacts on.
+
+        Reads device channel mapping and starts haptic material playback.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|General")
+    void SetTsDevice(UTsDevice* Device_);
+
+    /*!
+        \brief Adds impact with intensity [0..1] to the bone for the current frame.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
+    void AddImpact(FTsBoneIndex Bone, float Intensity);
+
+private:
+    UFUNCTION()
+    void OnOwnerHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+    void StartMaterial();
+    void StopMaterial();
+    void Flush(float DeltaTime);
+
+public:
+    /*!
+        \brief Haptic material asset which channel impacts are driven by contacts.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    UTsAsset* MaterialAsset = nullptr;
+
+    /*!
+        \brief How contacts of a single bone are combined.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    ETsImpactReduction Reduction = ETsImpactReduction::Max;
+
+    /*!
+        \brief Impact fade speed per second for Decay reduction.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float DecayRate = 8.0f;
+
+    /*!
+        \brief Scale from contact normal impulse to impact intensity.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float ImpulseScale = 0.001f;
+
+    /*!
+        \brief Minimal impact change which is sent to device.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float ChangeThreshold = 0.02f;
+
+    /*!
+        \brief Subscribe to hits of owner's primitive components.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    bool bListenOwnerHits = true;
+
+    /*!
+        \brief Maps physics body names of hit components to suit bones.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    TMap<FName, FTsBoneIndex> BodyToBone;
+
+    /*!
+        \brief Bone for contacts which body is not listed in BodyToBone.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    FTsBoneIndex DefaultBone = FTsBoneIndex::TsBoneIndex_Chest;
+
+private:
+    static constexpr std::size_t BonesCount = static_cast<std::size_t>(FTsBoneIndex::TsBoneIndex_BonesCount);
+
+    UPROPERTY()
+    UTsDevice* Device = nullptr;
+
+    /*! Material asset loaded for the playing playable, MaterialAsset may be changed meanwhile. */
+    UPROPERTY()
+    UTsAsset* LoadedMaterial = nullptr;
+
+    void* LibHandle = nullptr;
+    std::uint64_t PlayableId = 0;
+    TsHapticMapping Mapping;
+
+    std::array<float, BonesCount> Pending;
+    std::array<float, BonesCount> Levels;
+    std::array<float, BonesCount> Flushed;
+    std::uint64_t PendingMask = 0;
+    std::uint64_t ActiveMask = 0;
+    std::vector<std::pair<void*, float>> Commands;
+};
+
+/**@}*/
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "CoreMinimal.h"
+#include "TsMocap.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Haptic channels of a device grouped by bones.
+
+    Walks device mapping once and caches handles of electric haptic channels for each bone,
+    so channel lookups on hot paths are plain array accesses.
+    Channel handles can be passed to dynamic playables and material channel impacts.
+*/
+class TESLASUIT_API TsHapticMapping
+{
+public:
+    using Channels = std::vector<void*>;
+
+public:
+    /*!
+        \brief Reads electric channel layout from device mapping.
+
+        \return bool
+    */
+    bool Build(void* LibHandle, void* DeviceHandle);
+
+    /*!
+        \brief Returns channels bound to the bone.
+
+        \return Channels
+    */
+    const Channels& GetChannels(FTsBoneIndex Bone) const;
+
+    /*!
+        \brief Returns whether mapping was built.
+
+        \return bool
+    */
+    bool IsValid() const;
+
+    /*!
+        \brief Drops cached channels.
+    */
+    void Reset();
+
+private:
+    static constexpr std::size_t BonesCount = static_cast<std::size_t>(FTsBoneIndex::TsBoneIndex_BonesCount);
+
+    std::array<Channels, BonesCount> BoneChannels;
+    bool bValid = false;
+};
+
+/**@}*/
@@ -0,0 +1,150 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "CoreMinimal.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Pool of dynamic haptic playables.
+
+    Creating and removing playables per haptic event is expensive, so the pool keeps
+    pre-created playables for each device and asset and recycles them.
+    Dynamic playables are created from assets without predefined channels (Touch, TouchSequence, HapticMaterial),
+    channels are attached with #SetChannels and kept between uses, so only changed channels are sent to device.
+
+    Typical usage for localized effects with high churn:
+        - #Reserve playables for the effect asset on the device
+        - #Acquire playable and #SetChannels to place the effect on the body
+        - #Play playable, it will be recycled automatically when it finishes
+
+    Pool grows on demand, so in steady state no playables are created or removed.
+    Assets should be loaded with #TsHapticAssetManager before they are passed to the pool.
+*/
+class TESLASUIT_API TsHapticPlayablePool
+{
+public:
+    /*!
+        \brief Usage counters of the pool.
+    */
+    struct Stats
+    {
+        std::uint64_t Created = 0;
+        std::uint64_t Reused = 0;
+        std::uint64_t Recycled = 0;
+        std::uint64_t ChannelsAdded = 0;
+        std::uint64_t ChannelsRemoved = 0;
+    };
+
+public:
+    TsHapticPlayablePool();
+    ~TsHapticPlayablePool();
+
+    // Client methods
+
+    /*!
+        \brief Pre-creates playables of asset for device, so acquiring them later doesn't create new playables.
+    */
+    void Reserve(void* DeviceHandle, void* AssetHandle, std::size_t Count);
+
+    /*!
+        \brief Acquires free playable of asset for device.
+
+        Recycles finished playables if there are no free ones, creates a new playable only if pool is exhausted.
+        Returns 0 on failure.
+
+        \return std::uint64_t
+    */
+    std::uint64_t Acquire(void* DeviceHandle, void* AssetHandle);
+
+    /*!
+        \brief Sets channels of acquired playable.
+
+        Only the difference with currently attached channels is sent to device,
+        so reusing playable on the same channels costs no API calls.
+    */
+    void SetChannels(void* DeviceHandle, std::uint64_t PlayableId, const std::vector<void*>& Channels);
+
+    /*!
+        \brief Plays acquired playable.
+
+        If bReleaseOnFinish is set, playable returns to the pool once it's finished playing.
+    */
+    void Play(void* DeviceHandle, std::uint64_t PlayableId, bool bReleaseOnFinish = true);
+
+    /*!
+        \brief Stops playable and returns it to the pool.
+
+        Attached channels are kept until the playable is acquired again.
+    */
+    void Release(void* DeviceHandle, std::uint64_t PlayableId);
+
+    /*!
+        \brief Returns finished playables to the pool.
+
+        Called periodically by the plugin module and when pool has no free playables.
+    */
+    void Update();
+
+    /*!
+        \brief Removes all pooled playables of the asset, must be called before asset handle is unloaded.
+    */
+    void RemoveAsset(void* AssetHandle);
+
+    /*!
+        \brief Forgets all pooled playables of the disconnected device, no API calls are made with its handle.
+    */
+    void RemoveDevice(void* DeviceHandle);
+
+    /*!
+        \brief Removes all pooled playables for all devices.
+    */
+    void Clear();
+
+    /*!
+        \brief Returns usage counters of the pool.
+    */
+    const Stats& GetStats() const;
+
+    // Configure methods
+
+    /*!
+        \brief Set Teslasuit C API library.
+    */
+    void SetLibHandle(void* Handle);
+
+private:
+    struct Playable
+    {
+        void* AssetHandle = nullptr;
+        std::vector<void*> Channels;
+        bool bInUse = false;
+        bool bReleaseOnFinish = false;
+    };
+
+    struct DevicePool
+    {
+        std::map<std::uint64_t, Playable> Playables;
+        std::map<void*, std::vector<std::uint64_t>> FreeIds;
+    };
+
+    std::uint64_t CreatePlayable(void* DeviceHandle, void* AssetHandle);
+    void Recycle(void* DeviceHandle, DevicePool& Pool);
+    void ReturnToPool(DevicePool& Pool, std::uint64_t PlayableId, Playable& Item);
+    Playable* FindPlayable(void* DeviceHandle, std::uint64_t PlayableId);
+
+private:
+    void* LibHandle = nullptr;
+    std::map<void*, DevicePool> Pools;
+    Stats Counters;
+
+    struct ApiFunctions;
+    std::unique_ptr<ApiFunctions> Api;
+};
+
+/**@}*/
@@ -1,9 +1,12 @@
 #pragma once
 #include <map>
+#include <memory>
+#include <vector>
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "TsAsset.h"
 #include "TsDevice.h"
+#include "Haptic/TsHapticVoiceManager.h"
 #include "TsHapticPlayer.generated.h"
 
 /**
@@ -11,6 +14,11 @@
  * @{
  */
 
+/*!
+    \brief Notification on playlist asset finished playing.
+*/
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTsHapticPlaybackFinishedDelegate, int32, Index);
+
 /*!
     \brief Controls haptic playback for provides #UTsDevice.
 
@@ -18,6 +26,10 @@
     Player should be assigned to specific device using SetTsDevice function.
     Player Playlist can be filled with haptic assets.
     Assets can be played with Play functiton by index in Playlist.
+    Playback goes through #TsHapticVoiceManager, so when device playback capacity is saturated
+    less important assets are virtualized or stolen in favor of more important ones.
+    Playback state of all playlist assets is refreshed once per frame on haptic thread,
+    state getters read the snapshot and don't call device.
  */
 UCLASS(ClassGroup=Teslasuit, Category = "Teslasuit", meta=(BlueprintSpawnableComponent))
 class TESLASUIT_API UTsHapticPlayer : public UActorComponent
@@ -42,12 +54,36 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Teslasuit|General")
     void SetTsDevice(UTsDevice* Device_);
 
+    /*!
+        \brief Returns device the player plays haptic on.
+
+        \return #UTsDevice
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|General")
+    UTsDevice* GetTsDevice() const;
+
     /*!
         \brief Plays haptic asset from HapticAssets array by index.
+
+        Uses DefaultVoiceParams for voice management.
     */
     UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
     void Play(int Index);
 
+    /*!
+        \brief Plays haptic asset from HapticAssets array by index with provided voice parameters.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
+    void PlayWithParams(int Index, const FTsHapticVoiceParams& Params);
+
+    /*!
+        \brief Plays haptic asset from HapticAssets array by index for event at world location.
+
+        Distance from the owner to the location attenuates voice importance.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
+    void PlayAtLocation(int Index, FVector Location, ETsHapticPriority Priority = ETsHapticPriority::Normal, float Importance = 1.0f);
+
     /*!
         \brief Stops haptic asset from HapticAssets array by index.
     */
@@ -60,8 +96,45 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
     void StopPlayer();
 
+    /*!
+        \brief Returns voice management counters of all devices.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    FTsHapticVoiceStats GetVoiceStats() const;
+
+    /*!
+        \brief Returns whether asset from Playlist by index is playing.
+
+        State is refreshed once per frame, stolen and virtualized assets count as playing until their voice finishes.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    bool IsPlaying(int Index) const;
+
+    /*!
+        \brief Returns playback time in seconds of asset from Playlist by index.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    float GetPlaybackTime(int Index) const;
+
+    /*!
+        \brief Returns duration in seconds of asset from Playlist by index, 0 if not known yet.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    float GetPlaybackDuration(int Index) const;
+
+    /*!
+        \brief Returns playback progress [0..1] of asset from Playlist by index.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Haptic")
+    float GetPlaybackProgress(int Index) const;
+
 private:
     void InitializePlayables();
+    void ReleasePlayables();
+    void ResetSnapshot();
+    void ApplySnapshot();
+    void RequestSnapshot();
+    void MarkPlaying(int Index, bool bPlaying);
 
 public:
     /*!
@@ -72,6 +145,21 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
     TArray<UTsAsset*> Playlist;
 
+    /*!
+        \brief Voice parameters used by Play.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    FTsHapticVoiceParams DefaultVoiceParams;
+
+    /*!
+        \brief Notification on playlist asset finished playing by itself.
+
+        Assets stopped with Stop or StopPlayer don't trigger it,
+        stolen and virtualized assets trigger it only once their voice is finished.
+    */
+    UPROPERTY(BlueprintAssignable, Category = "Teslasuit|Haptic")
+    FTsHapticPlaybackFinishedDelegate OnPlaybackFinished;
+
 private:
 	void* LibHandle = nullptr;
 
@@ -82,6 +170,20 @@ private:
     UTsDevice* Device = nullptr;
 
 	std::map<uint32, std::uint64_t> PlayableIds;
+
+    struct PlayableState
+    {
+        bool bPlaying = false;
+        float Time = 0.0f;
+        float Duration = 0.0f;
+    };
+
+    // Snapshot read by getters and generation of local changes per playlist index
+    std::vector<PlayableState> Snapshot;
+    std::vector<uint32> Generations;
+
+    struct SnapshotRequest;
+    std::shared_ptr<SnapshotRequest> Request;
 };
 
 /**@}*/
@@ -0,0 +1,51 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Worker thread for haptic C API commands.
+
+    Class shouldn't be used directly for playback control, it's used by haptic components
+    to move batches of C API calls off the game thread.
+    Commands are executed in the order they were enqueued.
+*/
+class TESLASUIT_API TsHapticThread
+{
+public:
+    using Command = std::function<void()>;
+
+public:
+    TsHapticThread();
+    ~TsHapticThread();
+
+    /*!
+        \brief Queues command for execution on haptic thread.
+    */
+    void Enqueue(Command&& Cmd);
+
+    /*!
+        \brief Waits until commands enqueued before the call are executed, must not be called from haptic thread.
+    */
+    void Flush();
+
+private:
+    void Run();
+
+private:
+    std::mutex QueueMutex;
+    std::condition_variable QueueCondition;
+    std::deque<Command> Queue;
+    std::atomic_bool bFinished = false;
+    std::thread Thread;
+};
+
+/**@}*/
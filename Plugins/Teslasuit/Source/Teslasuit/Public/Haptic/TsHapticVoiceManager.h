@@ -0,0 +1,244 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "CoreMinimal.h"
+#include "TsHapticVoiceManager.generated.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Priority class of haptic playback.
+
+    Voices of higher class always win over voices of lower class regardless of their importance.
+*/
+UENUM(BlueprintType)
+enum class ETsHapticPriority : uint8
+{
+    Low = 0,
+    Normal = 1,
+    High = 2,
+    Critical = 3
+};
+
+/*!
+    \brief State of playable voice.
+*/
+UENUM(BlueprintType)
+enum class ETsHapticVoiceState : uint8
+{
+    /*! Voice is playing on device. */
+    Playing = 0,
+    /*! Voice waits for a free slot and hasn't played yet. */
+    Virtual = 1,
+    /*! Voice was stopped in favor of more important one and waits for a free slot. */
+    Stolen = 2,
+    /*! Voice isn't managed anymore: its timeline ended, it was dropped or stopped. */
+    Finished = 3
+};
+
+/*!
+    \brief Playback parameters used for voice scoring.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsHapticVoiceParams
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Priority class of the voice.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic")
+    ETsHapticPriority Priority = ETsHapticPriority::Normal;
+
+    /*!
+        \brief Importance of the voice inside its priority class.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float Importance = 1.0f;
+
+    /*!
+        \brief Distance from the wearer to the haptic event source.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0"))
+    float Distance = 0.0f;
+};
+
+/*!
+    \brief Counters of haptic voice management.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsHapticVoiceStats
+{
+    GENERATED_BODY()
+
+    /*! Voices currently playing on devices. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Active = 0;
+
+    /*! Voices currently waiting for a free slot. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Virtual = 0;
+
+    /*! Total number of voices stopped in favor of more important ones. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Stolen = 0;
+
+    /*! Total number of voices virtualized instead of being played. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Virtualized = 0;
+
+    /*! Total number of virtual voices resumed on a free slot. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Revived = 0;
+
+    /*! Total number of virtual voices that finished before getting a slot. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 Dropped = 0;
+};
+
+/*!
+    \brief Limits concurrent haptic playback per device.
+
+    Works like an audio voice manager in front of the haptic C API.
+    Each device has a limited number of voices (see "Teslasuit.Haptic.MaxVoices" console variable).
+    When all voices are busy, the lowest scored voice is stolen if the new one scores higher,
+    otherwise the new voice is virtualized: it keeps its timeline and resumes from the right
+    offset once a voice frees up, or is dropped if it finishes first.
+    Virtual voices of unknown duration are dropped after "Teslasuit.Haptic.VirtualVoiceTimeout" seconds.
+
+    Score is ordered by priority class first, then by importance attenuated by distance.
+    Ties are resolved by start order, the oldest voice is stolen first, so stealing is deterministic.
+
+    #UTsHapticPlayer plays all assets through the manager.
+*/
+class TESLASUIT_API TsHapticVoiceManager
+{
+public:
+    TsHapticVoiceManager();
+    ~TsHapticVoiceManager();
+
+    // Client methods
+
+    /*!
+        \brief Requests playback of the playable.
+
+        Returns true if playable has started playing, false if it was virtualized.
+        Known Duration in seconds, e.g. from asset metadata, saves duration query to device.
+
+        \return bool
+    */
+    bool Play(void* DeviceHandle, std::uint64_t PlayableId, const FTsHapticVoiceParams& Params, double Duration = 0.0);
+
+    /*!
+        \brief Assigns voice to the playable like #Play, but leaves starting the playable to the caller.
+
+        Returns true if caller must start the playable now, false if it was virtualized.
+        Lets callers dispatch play commands of several devices at once, e.g. broadcasts.
+
+        \return bool
+    */
+    bool Admit(void* DeviceHandle, std::uint64_t PlayableId, const FTsHapticVoiceParams& Params, double Duration = 0.0);
+
+    /*!
+        \brief Stops playable voice, real or virtual.
+    */
+    void Stop(void* DeviceHandle, std::uint64_t PlayableId);
+
+    /*!
+        \brief Returns state of playable voice, stolen and virtual voices are still on their timeline.
+
+        \return ETsHapticVoiceState
+    */
+    ETsHapticVoiceState GetVoiceState(void* DeviceHandle, std::uint64_t PlayableId) const;
+
+    /*!
+        \brief Forgets real and virtual voices of the device, e.g. after its player was stopped.
+    */
+    void StopDevice(void* DeviceHandle);
+
+    /*!
+        \brief Forgets all voices and cached data of the device without stopping them.
+    */
+    void RemoveDevice(void* DeviceHandle);
+
+    /*!
+        \brief Expires finished voices and resumes virtual voices on free slots.
+
+        Can be called from several places each frame, voices are updated only once per frame.
+    */
+    void Update();
+
+    /*!
+        \brief Adds measured delay between a playback command and its effect on the device, in seconds.
+    */
+    void ReportCommandLatency(void* DeviceHandle, double Latency);
+
+    /*!
+        \brief Returns smoothed command latency of the device in seconds, 0 if not measured yet.
+
+        \return double
+    */
+    double GetCommandLatency(void* DeviceHandle) const;
+
+    /*!
+        \brief Overrides voices limit of the device, 0 restores default limit.
+    */
+    void SetMaxVoices(void* DeviceHandle, int32 MaxVoices);
+
+    /*!
+        \brief Returns voice management counters.
+
+        \return FTsHapticVoiceStats
+    */
+    FTsHapticVoiceStats GetStats() const;
+
+    // Configure methods
+
+    /*!
+        \brief Set Teslasuit C API library.
+    */
+    void SetLibHandle(void* Handle);
+
+private:
+    struct Voice
+    {
+        std::uint64_t PlayableId = 0;
+        ETsHapticVoiceState State = ETsHapticVoiceState::Playing;
+        ETsHapticPriority Priority = ETsHapticPriority::Normal;
+        float Score = 0.0f;
+        double StartTime = 0.0;
+        double EndTime = 0.0;
+        std::uint64_t Sequence = 0;
+    };
+
+    struct DeviceVoices
+    {
+        std::vector<Voice> Real;
+        std::vector<Voice> Virtual;
+        int32 MaxVoices = 0;
+    };
+
+    static bool IsLess(const Voice& Lhs, const Voice& Rhs);
+    double GetDuration(void* DeviceHandle, std::uint64_t PlayableId);
+    void Start(void* DeviceHandle, const Voice& Item, double Now);
+    int32 GetMaxVoices(const DeviceVoices& Voices) const;
+
+private:
+    void* LibHandle = nullptr;
+    std::map<void*, DeviceVoices> Devices;
+    std::map<std::pair<void*, std::uint64_t>, double> Durations;
+    std::map<void*, double> CommandLatencies;
+    std::uint64_t NextSequence = 0;
+    std::uint64_t LastUpdateFrame = 0;
+    FTsHapticVoiceStats Stats;
+
+    struct ApiFunctions;
+    std::unique_ptr<ApiFunctions> Api;
+};
+
+/**@}*/
@@ -177,6 +177,9 @@
 
 class TsDeviceProvider;
 class TsHapticAssetManager;
+class TsHapticPlayablePool;
+class TsHapticThread;
+class TsHapticVoiceManager;
 
 /*!
 	\brief Interface of Teslasuit module.
@@ -187,6 +190,9 @@ class TsHapticAssetManager;
     - C API library handle
     - device provider instance
     - haptic asset manager instance
+    - haptic playable pool instance
+    - haptic thread instance
+    - haptic voice manager instance
 */
 class TESLASUIT_API ITeslasuitPlugin : public IModuleInterface
 {
@@ -242,6 +248,30 @@ public:
 		\return #TsHapticAssetManager
 	*/
 	virtual TsHapticAssetManager& GetHapticAssetManager() = 0;
+
+	/*!
+		\brief Returns a reference for instance of #TsHapticPlayablePool.
+
+        Pool of dynamic playables shared by all haptic players of the application.
+		\return #TsHapticPlayablePool
+	*/
+	virtual TsHapticPlayablePool& GetHapticPlayablePool() = 0;
+
+	/*!
+		\brief Returns a reference for instance of #TsHapticThread.
+
+        Worker thread which executes batched haptic C API calls off the game thread.
+		\return #TsHapticThread
+	*/
+	virtual TsHapticThread& GetHapticThread() = 0;
+
+	/*!
+		\brief Returns a reference for instance of #TsHapticVoiceManager.
+
+        Voice manager limits concurrent playback per device for all haptic players.
+		\return #TsHapticVoiceManager
+	*/
+	virtual TsHapticVoiceManager& GetHapticVoiceManager() = 0;
 };
 
 /**@}*/
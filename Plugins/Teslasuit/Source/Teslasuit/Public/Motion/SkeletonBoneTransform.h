@@ -4,8 +4,11 @@
 #include "Runtime/Engine/Public/Animation/AnimInstanceProxy.h"
 #include "Runtime/AnimGraphRuntime/Public/BoneControllers/AnimNode_SkeletalControlBase.h"
 #include "TsMocap.h"
+#include "Motion/TsRetargetProfile.h"
 #include "SkeletonBoneTransform.generated.h"
 
+class UTsMotionAnimation;
+
 /**
  * \addtogroup mocap
  * @{
@@ -44,11 +47,20 @@ public:
     virtual void GatherDebugData(FNodeDebugData& DebugData) override;
     virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
     virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+    virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
 
 private:
     virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
 
+    void EvaluateProfile(FComponentSpacePoseContext& Output, const UTsMotionAnimation* Animation, std::uint64_t EvaluatedBones);
+
 public:
+    /*!
+        \brief Bone mapping with offsets, replaces BonesToModify and RotationOffsets when set.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    UTsRetargetProfile* Profile = nullptr;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
     TArray<FBonePair> BonesToModify;
 
@@ -73,6 +85,13 @@ public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Rotation, meta = (PinShownByDefault))
     TMap<FTsBoneIndex, FTransform> data;
+
+private:
+    // Profile table of current required bones, parents precede children
+    TArray<FCompactPoseBoneIndex> ProfileBones;
+    TArray<uint8> ProfileMocapBones;
+    TArray<FQuat> ProfileOffsets;
+    std::uint64_t ProfileMask = 0;
 };
 
 /**@}*/
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TsMocapCapture.generated.h"
+
+class USkeleton;
+class UAnimSequence;
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Parameters of baking captured mocap into animation asset.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsMocapBakeSettings
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Skeleton of baked animation, skeleton of the motion mesh if not set.
+
+        Bones are matched by names of the Teslasuit anim node mapping.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    USkeleton* TargetSkeleton = nullptr;
+
+    /*!
+        \brief Content folder of baked animation.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    FString PackagePath = TEXT("/Game/Teslasuit/Mocap");
+
+    /*!
+        \brief Name of baked animation, time of capture stop if empty.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    FString AssetName;
+
+    /*!
+        \brief Key rate of baked animation, captured stream is resampled to it.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "1"))
+    int32 FrameRate = 60;
+
+    /*!
+        \brief Bone tracks rotating less than this over the whole capture, in degrees, are reduced to a single key.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float RotationTolerance = 0.1f;
+
+    /*!
+        \brief Bone tracks moving less than this over the whole capture, in Unreal units, are reduced to a single key.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float TranslationTolerance = 0.01f;
+};
+
+/*!
+    \brief Called on game thread when captured mocap is baked, nullptr if baking failed.
+*/
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTsMocapBakedDelegate, UAnimSequence*, Sequence);
+
+/**@}*/
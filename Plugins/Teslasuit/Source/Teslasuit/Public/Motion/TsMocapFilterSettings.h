@@ -0,0 +1,84 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TsMocap.h"
+#include "TsMocapFilterSettings.generated.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Smoothing filter applied to mocap poses.
+*/
+UENUM(BlueprintType)
+enum class ETsMocapFilterType : uint8
+{
+    /*! Poses are passed as received. */
+    None = 0,
+    /*! Exponential smoothing with fixed cutoff frequency. */
+    Exponential = 1,
+    /*! One-Euro filter, cutoff frequency grows with bone speed. */
+    OneEuro = 2
+};
+
+/*!
+    \brief Smoothing parameters of a single bone.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsMocapBoneFilter
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Cutoff frequency in Hz of still bone, lower values smooth more.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.01"))
+    float MinCutoff = 1.0f;
+
+    /*!
+        \brief Cutoff growth with bone speed, higher values reduce lag of fast motion. Used by One-Euro filter.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float Beta = 0.5f;
+
+    /*!
+        \brief Cutoff frequency in Hz of bone speed estimation. Used by One-Euro filter.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.01"))
+    float DerivativeCutoff = 1.0f;
+};
+
+/*!
+    \brief Data asset with smoothing parameters of mocap bones.
+
+    Assigned to #UTsMocap with SetFilterSettings, filtering runs on the mocap stream worker
+    at the sensor rate, so results don't depend on game frame rate.
+*/
+UCLASS(BlueprintType)
+class TESLASUIT_API UTsMocapFilterSettings : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /*!
+        \brief Filter applied to all bones.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Teslasuit|Mocap")
+    ETsMocapFilterType FilterType = ETsMocapFilterType::OneEuro;
+
+    /*!
+        \brief Parameters of bones not listed in BoneFilters.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Teslasuit|Mocap")
+    FTsMocapBoneFilter DefaultFilter;
+
+    /*!
+        \brief Per bone parameters.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Teslasuit|Mocap")
+    TMap<FTsBoneIndex, FTsMocapBoneFilter> BoneFilters;
+};
+
+/**@}*/
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include "CoreMinimal.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Suit skeleton pose converted to UE coordinates.
+
+    Rotations and translations are kept in separate aligned streams indexed by #FTsBoneIndex,
+    only bones set in BoneMask carry data.
+*/
+struct TESLASUIT_API TsMocapFrame
+{
+    static constexpr int32 BonesCount = 50;
+
+    alignas(16) FQuat4f Rotations[BonesCount];
+    alignas(16) FVector4f Translations[BonesCount];
+    /*! Angular velocities in bone local space of Rotations (rotation offsets included), radians per second. */
+    alignas(16) FVector4f AngularVelocities[BonesCount];
+    /*! Linear accelerations in bone local space of Rotations (rotation offsets included), meters per second squared like translations. */
+    alignas(16) FVector4f Accelerations[BonesCount];
+    /*! Linear velocities in pose space estimated from consecutive frames, meters per second. */
+    alignas(16) FVector4f LinearVelocities[BonesCount];
+    /*! Bones which have sensor readings. */
+    std::uint64_t SensorMask = 0;
+    /*! Platform time of sensor readings arrival. */
+    double SensorTime = 0.0;
+    std::uint64_t BoneMask = 0;
+    std::uint64_t Sequence = 0;
+    /*! Changes when pose moves beyond idle thresholds, frames of equal version carry the same pose. */
+    std::uint64_t PoseVersion = 0;
+
+    /*! Platform time of capture estimated from device clock of sensor stream, 0 if unknown. */
+    double DeviceTime = 0.0;
+    /*! Platform time of device callback arrival. */
+    double CaptureTime = 0.0;
+    /*! Platform time when the frame was published to consumers. */
+    double PublishTime = 0.0;
+
+    /*!
+        \brief Returns bone transform.
+    */
+    FTransform GetTransform(int32 Bone) const
+    {
+        const auto& T = Translations[Bone];
+        return FTransform(FQuat(Rotations[Bone]), FVector(T.X, T.Y, T.Z));
+    }
+
+    /*!
+        \brief Is bone present in the frame.
+    */
+    bool HasBone(int32 Bone) const
+    {
+        return (BoneMask & (1ull << Bone)) != 0;
+    }
+};
+
+/**@}*/
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include "CoreMinimal.h"
+#include "Motion/TsMocapFrame.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Single producer, multiple consumer broadcast ring of mocap frames.
+
+    Producer writes frames into a fixed ring of slots and never waits for readers.
+    Each reader has its own cursor and reads frames in place, slot versions tell whether
+    a frame was overwritten while it was read. A reader which falls behind by the whole ring
+    skips ahead to the latest frame, so slow consumers don't stall the producer
+    and adding consumers doesn't add producer work.
+*/
+class TESLASUIT_API TsMocapFrameBus
+{
+public:
+    static constexpr std::uint64_t SlotsCount = 8;
+
+    /*!
+        \brief Cursor of a single consumer, must be used from one thread.
+    */
+    class TESLASUIT_API Reader
+    {
+    public:
+        explicit Reader(std::shared_ptr<const TsMocapFrameBus> Bus_);
+
+        /*!
+            \brief Returns next unread frame or nullptr if there are no new frames.
+
+            Frame is read in place, #EndRead must be called after reading it.
+        */
+        const TsMocapFrame* BeginRead();
+
+        /*!
+            \brief Finishes reading, returns false if the frame was overwritten meanwhile and must be discarded.
+        */
+        bool EndRead();
+
+        /*!
+            \brief Moves cursor to the latest published frame.
+        */
+        void SkipToLatest();
+
+        /*!
+            \brief Number of frames skipped because reader was too slow.
+        */
+        std::uint64_t GetSkipped() const { return Skipped; }
+
+        /*!
+            \brief Number of frames overwritten while being read.
+        */
+        std::uint64_t GetTorn() const { return Torn; }
+
+    private:
+        std::shared_ptr<const TsMocapFrameBus> Bus;
+        std::uint64_t Cursor = 0;
+        std::uint64_t ExpectedVersion = 0;
+        std::uint64_t Skipped = 0;
+        std::uint64_t Torn = 0;
+    };
+
+public:
+    /*!
+        \brief Returns frame to be filled by producer.
+    */
+    TsMocapFrame& BeginWrite();
+
+    /*!
+        \brief Publishes frame filled after #BeginWrite.
+    */
+    void EndWrite();
+
+    /*!
+        \brief Number of frames published since creation.
+    */
+    std::uint64_t GetPublished() const;
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> Version{ 0 };
+        TsMocapFrame Frame;
+    };
+
+    Slot Slots[SlotsCount];
+    alignas(64) std::atomic<std::uint64_t> Published{ 0 };
+};
+
+/**@}*/
@@ -0,0 +1,61 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TsMocapPrediction.generated.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Parameters of mocap pose prediction from sensor angular velocity.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsMocapPredictionSettings
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Extrapolate poses to expected display time.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bEnabled = false;
+
+    /*!
+        \brief Time from pose consumption until it is displayed, in milliseconds.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float LeadTimeMs = 20.0f;
+
+    /*!
+        \brief Longest extrapolation from pose capture, in milliseconds.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float MaxHorizonMs = 50.0f;
+
+    /*!
+        \brief Decay rate of velocity over the horizon per second, higher values reduce overshoot.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float Damping = 10.0f;
+
+    /*!
+        \brief Bones rotating faster, in degrees per second, are not predicted as their readings are unreliable.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float MaxAngularSpeed = 1500.0f;
+
+    /*!
+        \brief Sensor readings older than this, in milliseconds, disable prediction.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float MaxSensorAgeMs = 30.0f;
+
+    /*!
+        \brief Also extrapolate bone translations from their velocity and linear acceleration.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bUseAcceleration = false;
+};
+
+/**@}*/
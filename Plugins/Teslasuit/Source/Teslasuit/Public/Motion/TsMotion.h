@@ -6,8 +6,15 @@
 #include "Runtime/Engine/Classes/Animation/AnimBlueprintGeneratedClass.h"
 #include "Motion/TsMotionAnimation.h"
 #include "TsMocap.h"
+#include "Motion/TsMocapFilterSettings.h"
+#include "Motion/TsMocapPrediction.h"
+#include "Motion/TsMotionLod.h"
+#include "Motion/TsMocapCapture.h"
 #include "TsMotion.generated.h"
 
+class FTsMocapLateUpdate;
+class TsMocapRecorder;
+
 /**
  * \addtogroup mocap
  * @{
@@ -37,17 +44,116 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
 	UTsMocap* mocap;
 
+	/*!
+		\brief Smoothing applied to mocap poses, assigned to mocap on begin play.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	UTsMocapFilterSettings* FilterSettings = nullptr;
+
+	/*!
+		\brief Re-applies the newest mocap pose to late update components right before rendering.
+
+		Cuts latency of bone-attached components, e.g. hand meshes in VR, by a frame or more.
+		Late update doesn't run animation, the skeletal mesh itself keeps the game thread pose.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	bool bLateUpdate = false;
+
+	/*!
+		\brief Extrapolation of poses to display time from sensor angular velocity, also used by late update.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	FTsMocapPredictionSettings Prediction;
+
+	/*!
+		\brief Detail reduction of far and not rendered characters.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	FTsMotionLodSettings Lod;
+
+	/*!
+		\brief Skips bone refresh of the skeletal mesh while mocap pose doesn't change.
+
+		Mesh keeps its last evaluated pose, so other animation of the anim graph also pauses
+		while the wearer stands still. Evaluation resumes on the first changed pose.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	bool bSkipIdleEvaluation = false;
+
+	/*!
+		\brief Animation asset baked from captured mocap by #StopCapture.
+	*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+	FTsMocapBakeSettings CaptureSettings;
+
+	/*!
+		\brief Called when captured mocap is baked.
+	*/
+	UPROPERTY(BlueprintAssignable, Category = "Teslasuit|Mocap")
+	FTsMocapBakedDelegate OnCaptureBaked;
+
+	/*!
+		\brief Starts recording every mocap frame of bones mapped by the animation, off the game thread.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	void StartCapture();
+
+	/*!
+		\brief Stops recording and bakes capture into animation sequence in background, see #OnCaptureBaked.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	void StopCapture();
+
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	bool IsCapturing() const;
+
+	/*!
+		\brief Returns detail level selected on last tick.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	ETsMotionLod GetLod() const;
+
 	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Biometry")
 	void SetSkeletalMesh(USkeletalMeshComponent* skeletalMesh);
+
+	/*!
+		\brief Makes component attached to the bone follow its newest pose on render thread.
+
+		Bone must be driven by a Teslasuit anim node of the animation.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	void AddLateUpdateComponent(USceneComponent* Component, FTsBoneIndex Bone);
+
+	/*!
+		\brief Stops late update of the component.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+	void RemoveLateUpdateComponent(USceneComponent* Component);
 protected:
     virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     virtual void UninitializeComponent() override;
     
+private:
+	void AddLateUpdateTarget(USceneComponent* Component, FTsBoneIndex Bone);
+	void UpdateLateUpdate(std::uint64_t BoneMask, const FQuat4f* Rotations, double DisplayTime);
+	ETsMotionLod SelectLod() const;
+	void SetPoseIdle(bool bIdle);
+
 private:
 	UTsMotionAnimation* MotionAnimation;
 	USkeletalMeshComponent* SkeletalMesh;
+	std::unique_ptr<TsMocapFrameBus::Reader> FrameReader;
+	const TsMocapFrameBus* ReaderBus = nullptr;
+	TSharedPtr<FTsMocapLateUpdate, ESPMode::ThreadSafe> LateUpdate;
+	TArray<TPair<TWeakObjectPtr<USceneComponent>, FTsBoneIndex>> LateUpdateComponents;
+	std::uint64_t SubscribedBones = 0;
+	ETsMotionLod CurrentLod = ETsMotionLod::Full;
+	double LastPoseTime = 0.0;
+	std::uint64_t AppliedPoseVersion = 0;
+	std::uint64_t AppliedBoneMask = 0;
+	std::shared_ptr<TsMocapRecorder> Recorder;
 
 
 	FTimerHandle TickCallibrationTimer;
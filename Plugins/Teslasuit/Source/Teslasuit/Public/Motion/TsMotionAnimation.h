@@ -1,4 +1,7 @@
 #pragma once
+#include <map>
+#include <atomic>
+#include <cstdint>
 #include "CoreMinimal.h"
 #include "Runtime/Engine/Classes/Animation/AnimInstance.h"
 #include "TsMocap.h"
@@ -24,9 +27,77 @@ public:
 
     virtual void NativeUpdateAnimation(float DeltaTimeX) override;
 
+    /*!
+        \brief Stamps the pose written to data for latency tracking.
+
+        OriginTime is platform time of pose capture, PickupTime is when the pose was read from mocap.
+    */
+    void SetPoseTimes(double OriginTime, double PickupTime);
+
+    /*!
+        \brief Declares mocap bones evaluated by the anim node, can be called from any thread.
+    */
+    void SetRequiredBones(const void* Node, std::uint64_t Mask);
+
+    /*!
+        \brief Returns mocap bones evaluated by anim nodes, zero if unknown.
+    */
+    std::uint64_t GetRequiredBones() const;
+
+    /*!
+        \brief Limits bones applied by anim nodes to the mask, e.g. by detail level of #UTsMotion.
+    */
+    void SetEvaluatedBones(std::uint64_t Mask);
+
+    /*!
+        \brief Returns bones anim nodes should apply, can be called from any thread.
+    */
+    std::uint64_t GetEvaluatedBones() const;
+
+    /*!
+        \brief Writes rotations of bones in the mask, indexed by #FTsBoneIndex, anim nodes with retarget profile read them without lookups.
+
+        Game thread only, anim nodes see the pose after next animation update.
+    */
+    void SetPoseRotations(std::uint64_t Mask, const FQuat4f* Rotations);
+
+    /*!
+        \brief Forgets written rotations, e.g. when the pose comes from another stream. Game thread only.
+    */
+    void ResetPose();
+
+    /*!
+        \brief Bones of the pose taken on last animation update, anim nodes read it on worker threads.
+    */
+    std::uint64_t GetPoseMask() const { return PoseMask; }
+
+    const FQuat4f* GetPoseRotations() const { return PoseRotations; }
+
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit")
     TMap<FTsBoneIndex, FTransform> data;
+
+    /*!
+        \brief Mocap pose hasn't changed since last update, graph may skip work depending on data.
+    */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit")
+    bool bPoseIdle = false;
+
+private:
+    double PoseOriginTime = 0.0;
+    double PosePickupTime = 0.0;
+
+    mutable FCriticalSection RequiredBonesLock;
+    std::map<const void*, std::uint64_t> RequiredBones;
+    std::atomic<std::uint64_t> EvaluatedBones{ ~0ull };
+
+    // Written by game thread
+    std::uint64_t PendingPoseMask = 0;
+    FQuat4f PendingPoseRotations[static_cast<int32>(FTsBoneIndex::TsBoneIndex_BonesCount)];
+
+    // Copied on animation update, read by anim nodes during evaluation
+    std::uint64_t PoseMask = 0;
+    FQuat4f PoseRotations[static_cast<int32>(FTsBoneIndex::TsBoneIndex_BonesCount)];
 };
 
 /**@}*/
@@ -0,0 +1,83 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TsMotionLod.generated.h"
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Detail level of mocap driven character, each level includes reductions of previous ones.
+*/
+UENUM(BlueprintType)
+enum class ETsMotionLod : uint8
+{
+    /*! All streamed bones are applied every frame. */
+    Full = 0,
+    /*! Finger bones are not streamed nor evaluated. */
+    NoFingers = 1,
+    /*! Poses are applied at reduced rate. */
+    Reduced = 2,
+    /*! Poses are not applied, character keeps its last pose. */
+    Frozen = 3
+};
+
+/*!
+    \brief Policies reducing cost of mocap driven characters that are far away or not rendered.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsMotionLodSettings
+{
+    GENERATED_BODY()
+
+    /*!
+        \brief Select detail level from distance to the nearest local player camera and visibility.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bEnabled = false;
+
+    /*!
+        \brief Finger bones are dropped beyond this distance, in centimeters.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float FingerCullDistance = 1500.0f;
+
+    /*!
+        \brief Poses are applied at reduced rate beyond this distance, in centimeters.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float ReducedRateDistance = 3000.0f;
+
+    /*!
+        \brief Rate of pose updates at reduced level, in hertz.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "1.0"))
+    float ReducedRateHz = 15.0f;
+
+    /*!
+        \brief Characters not rendered recently are updated at reduced rate.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bReduceWhenNotRendered = true;
+
+    /*!
+        \brief Characters not rendered recently keep their last pose, also stops their anim instance update.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bFreezeWhenNotRendered = false;
+
+    /*!
+        \brief Time since last render after which character counts as not rendered, in seconds.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap", meta = (ClampMin = "0.0"))
+    float NotRenderedTime = 0.2f;
+
+    /*!
+        \brief Enables update rate optimizations of the skeletal mesh, so engine also skips and interpolates anim evaluation.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    bool bUseUpdateRateOptimizations = true;
+};
+
+/**@}*/
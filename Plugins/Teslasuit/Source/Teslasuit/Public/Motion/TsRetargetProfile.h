@@ -0,0 +1,87 @@
+#pragma once
+#include <memory>
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TsMocap.h"
+#include "TsRetargetProfile.generated.h"
+
+class USkeleton;
+
+/**
+ * \addtogroup mocap
+ * @{
+ */
+
+/*!
+    \brief Skeleton bone driven by a mocap bone.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsRetargetBone
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    FName BoneName;
+
+    /*!
+        \brief Component space rotation of the bone when mocap bone has identity rotation.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    FRotator Offset = FRotator::ZeroRotator;
+};
+
+/*!
+    \brief Profile compiled for a skeleton, entries are ordered by skeleton bone index so parents precede children.
+*/
+struct TESLASUIT_API TsRetargetTable
+{
+    TArray<int32> SkeletonBones;
+    TArray<uint8> MocapBones;
+    TArray<FQuat> Offsets;
+};
+
+/*!
+    \brief Data asset mapping mocap bones to bones of a character with rotation offsets.
+
+    Assigned to Teslasuit anim node, profile is compiled once per skeleton into flat tables,
+    so evaluation is a walk over arrays without name or map lookups.
+*/
+UCLASS(BlueprintType)
+class TESLASUIT_API UTsRetargetProfile : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /*!
+        \brief Skeleton used by auto mapping.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Teslasuit|Mocap")
+    USkeleton* Skeleton = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Teslasuit|Mocap")
+    TMap<FTsBoneIndex, FTsRetargetBone> Bones;
+
+    /*!
+        \brief Returns profile compiled for the skeleton, compiles it on first use. Can be called from any thread.
+    */
+    std::shared_ptr<const TsRetargetTable> GetTable(const USkeleton* TargetSkeleton) const;
+
+#if WITH_EDITOR
+    /*!
+        \brief Maps mocap bones to bones of Skeleton by common naming conventions.
+
+        Offsets are taken from the reference pose, which is expected to match the calibration pose of the suit.
+        Bones without matching names keep their current mapping.
+    */
+    UFUNCTION(CallInEditor, Category = "Teslasuit|Mocap")
+    void AutoMap();
+
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    mutable FCriticalSection TablesLock;
+    mutable TMap<TWeakObjectPtr<const USkeleton>, std::shared_ptr<const TsRetargetTable>> Tables;
+};
+
+/**@}*/
@@ -0,0 +1,57 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MovieSceneSection.h"
+#include "TsAsset.h"
+#include "MovieSceneTsHapticSection.generated.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Sequencer section that plays haptic asset on the timeline.
+
+    Section is evaluated on #UTsHapticPlayer of the bound actor and uses its device.
+    Playback position follows the sequence time with sub-frame precision, see #UMovieSceneTsHapticTrack.
+*/
+UCLASS()
+class TESLASUIT_API UMovieSceneTsHapticSection : public UMovieSceneSection
+{
+    GENERATED_BODY()
+
+public:
+    UMovieSceneTsHapticSection(const FObjectInitializer& ObjectInitializer);
+
+    /*!
+        \brief Haptic asset to play.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic")
+    UTsAsset* Asset = nullptr;
+
+    /*!
+        \brief Asset time in seconds played at the section start.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (ClampMin = "0.0", Units = "s"))
+    float StartOffset = 0.0f;
+
+    /*!
+        \brief Start haptic earlier by measured device latency.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic")
+    bool bCompensateLatency = true;
+
+    /*!
+        \brief Latency of the path not visible to the device, e.g. display latency, added to measured latency.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (Units = "ms"))
+    float ExtraLatencyMs = 0.0f;
+
+    /*!
+        \brief Difference between haptic and sequence positions that triggers resynchronization.
+    */
+    UPROPERTY(EditAnywhere, Category = "Teslasuit|Haptic", meta = (ClampMin = "1.0", Units = "ms"))
+    float ResyncThresholdMs = 20.0f;
+};
+
+/**@}*/
@@ -0,0 +1,59 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MovieSceneNameableTrack.h"
+#include "Compilation/IMovieSceneTrackTemplateProducer.h"
+#include "MovieSceneTsHapticTrack.generated.h"
+
+/**
+ * \addtogroup haptic
+ * @{
+ */
+
+/*!
+    \brief Sequencer track of haptic assets for actors with #UTsHapticPlayer.
+
+    Playables are created when a section enters its pre-roll, so playback starts without loading delay.
+    While the sequence plays, haptic playback is started ahead by measured device latency and
+    its position is kept in sync with the sequence time using device player time, jumps and
+    drift above section threshold are corrected with ts_haptic_set_playable_local_time.
+    Scrubbing, pausing and reverse playback stop the haptic.
+*/
+UCLASS()
+class TESLASUIT_API UMovieSceneTsHapticTrack : public UMovieSceneNameableTrack, public IMovieSceneTrackTemplateProducer
+{
+    GENERATED_BODY()
+
+public:
+    UMovieSceneTsHapticTrack(const FObjectInitializer& ObjectInitializer);
+
+    // UMovieSceneTrack interface
+    virtual bool SupportsType(TSubclassOf<UMovieSceneSection> SectionClass) const override;
+    virtual UMovieSceneSection* CreateNewSection() override;
+    virtual const TArray<UMovieSceneSection*>& GetAllSections() const override;
+    virtual bool HasSection(const UMovieSceneSection& Section) const override;
+    virtual void AddSection(UMovieSceneSection& Section) override;
+    virtual void RemoveSection(UMovieSceneSection& Section) override;
+    virtual void RemoveSectionAt(int32 SectionIndex) override;
+    virtual bool IsEmpty() const override;
+    virtual void RemoveAllAnimationData() override;
+    virtual bool SupportsMultipleRows() const override { return true; }
+
+#if WITH_EDITORONLY_DATA
+    virtual FText GetDefaultDisplayName() const override;
+#endif
+
+    // IMovieSceneTrackTemplateProducer interface
+    virtual FMovieSceneEvalTemplatePtr CreateTemplateForSection(const UMovieSceneSection& InSection) const override;
+
+public:
+    /*!
+        \brief Time before a section start when its playable is created.
+    */
+    static constexpr float PreRollSeconds = 0.5f;
+
+private:
+    UPROPERTY()
+    TArray<UMovieSceneSection*> Sections;
+};
+
+/**@}*/
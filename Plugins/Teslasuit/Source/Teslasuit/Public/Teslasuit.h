@@ -1,10 +1,14 @@
 #pragma once
 #include <memory>
 #include "Modules/ModuleManager.h"
+#include "Containers/Ticker.h"
 #include "ITeslasuitPlugin.h"
 #include "TsCore.h"
 #include "TsDeviceProvider.h"
 #include "Haptic/TsHapticAssetManager.h"
+#include "Haptic/TsHapticPlayablePool.h"
+#include "Haptic/TsHapticThread.h"
+#include "Haptic/TsHapticVoiceManager.h"
 
 /**
  * \addtogroup core
@@ -16,7 +20,7 @@
 
     Implementation of UE module and #ITeslasuitPlugin interface.
     Module is automatically loads and unloads C API library.
-    Provides access to device provider, haptic asset manager
+    Provides access to device provider, haptic asset manager, haptic playable pool
     and library handle for custom C API wrappers.
 */
 class FTeslasuitModule : public ITeslasuitPlugin
@@ -42,11 +46,18 @@ public:
     virtual void* GetLibHandle() const override;
     virtual TsDeviceProvider& GetDeviceProvider() override;
     virtual TsHapticAssetManager& GetHapticAssetManager() override;
+    virtual TsHapticPlayablePool& GetHapticPlayablePool() override;
+    virtual TsHapticThread& GetHapticThread() override;
+    virtual TsHapticVoiceManager& GetHapticVoiceManager() override;
 
 private:
     std::unique_ptr<TsCore> Core;
     std::unique_ptr<TsDeviceProvider> DeviceProvider;
     std::unique_ptr<TsHapticAssetManager> HapticAssetManager;
+    std::unique_ptr<TsHapticPlayablePool> HapticPlayablePool;
+    std::unique_ptr<TsHapticThread> HapticThread;
+    std::unique_ptr<TsHapticVoiceManager> HapticVoiceManager;
+    FTSTicker::FDelegateHandle PoolTickHandle;
 };
 
 /**@}*/
@@ -1,6 +1,8 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Async/Future.h"
+#include "Serialization/BulkData.h"
 #include "TsAsset.generated.h"
 
 /**
@@ -8,6 +10,21 @@
  * @{
  */
 
+/*!
+    \brief Type of Teslasuit asset.
+*/
+UENUM(BlueprintType)
+enum class ETsAssetType : uint8
+{
+    Undefined = 0,
+    Spline = 1,
+    HapticEffect = 2,
+    Material = 3,
+    TouchSequence = 4,
+    PresetAnimation = 5,
+    SceneAnimation = 6
+};
+
 /*!
    \brief Stores binary data of loaded Teslasuit Asset.
 
@@ -15,6 +32,16 @@
    Class is used by #UTsAssetFactory in module #TeslasuitAssetImporter to import ".ts_asset" files.
    #TeslasuitAssetImporter detects import of ".ts_asset" files and creates instances of #UTsAsset class.
    TS asset files can be created in Teslasuit Studio application.
+
+   Payload is stored in compressed bulk data, which is not loaded with the package.
+   It is read on first use, in background with #PreloadPayload or on demand with #AcquirePayload,
+   and the resident copy is released once it is handed over to the C API.
+
+   Asset type is read and validated on import, so runtime code doesn't need C API to get it.
+   Duration can be measured only with a playable, so it is set on import if a device is connected,
+   assets imported without device get it in editor once a device is connected on load.
+   Runtime users query unknown (0) duration from a playable and keep it in their own playback state.
+   Content hash identifies equal payloads, #TsHapticAssetManager loads them into C API once.
  */
 UCLASS(Blueprintable, Category = "Teslasuit")
 class TESLASUIT_API UTsAsset : public UObject
@@ -27,13 +54,100 @@ public:
     void Initialize(const uint8* Data_, std::size_t Size_);
 
     /*!
-        \brief Get data array reference.
+        \brief Starts reading payload in background if it isn't resident yet.
+    */
+    void PreloadPayload() const;
+
+    /*!
+        \brief Returns payload and releases its resident copy.
+
+        Waits for background read started by #PreloadPayload or reads payload synchronously.
+
+        \return TArray<uint8>
+    */
+    TArray<uint8> AcquirePayload() const;
+
+    /*!
+        \brief Drops resident payload and result of background read, e.g. when its duplicate is already loaded.
+    */
+    void ReleasePayload() const;
+
+    /*!
+        \brief Get uncompressed payload size.
+    */
+    int64 GetPayloadSize() const;
+
+    /*!
+        \brief Returns asset type detected on import.
+
+        \return ETsAssetType
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Asset")
+    ETsAssetType GetAssetType() const;
+
+    /*!
+        \brief Returns asset duration in seconds, 0 if it isn't known yet.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Asset")
+    float GetDuration() const;
+
+    /*!
+        \brief Returns SHA1 hash of the payload, assets with equal payloads share the hash.
     */
-    const TArray<uint8>& GetData() const;
-	
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Asset")
+    FString GetContentHash() const;
+
+    /*!
+        \brief Set asset type, called by importer.
+    */
+    void SetAssetType(ETsAssetType Type);
+
+    /*!
+        \brief Set asset duration, called by importer and on load in editor.
+    */
+    void SetDuration(float Seconds);
+
+    // UObject interface
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void PostLoad() override;
+    virtual bool IsReadyForFinishDestroy() override;
+    virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 private:
+    TArray<uint8> ReadPayload() const;
+    void SetResidentPayload(TArray<uint8>&& Bytes) const;
+
+private:
+    /*!
+        \brief Payload of assets saved before bulk data storage, moved to bulk data on load.
+    */
     UPROPERTY()
     TArray<uint8> Data;
+
+    /*!
+        \brief Asset type detected on import.
+    */
+    UPROPERTY(VisibleAnywhere, AssetRegistrySearchable, Category = "Teslasuit")
+    ETsAssetType AssetType = ETsAssetType::Undefined;
+
+    /*!
+        \brief Asset duration in seconds, 0 if unknown.
+    */
+    UPROPERTY(VisibleAnywhere, Category = "Teslasuit")
+    float Duration = 0.0f;
+
+    /*!
+        \brief SHA1 hash of the payload.
+    */
+    UPROPERTY(VisibleAnywhere, AssetRegistrySearchable, Category = "Teslasuit")
+    FString ContentHash;
+
+    FByteBulkData Payload;
+
+    mutable FCriticalSection PayloadLock;
+    mutable TArray<uint8> ResidentPayload;
+    mutable TFuture<void> PendingRead;
+    mutable bool bDiscardPendingRead = false;
 };
 
 /**@}*/
@@ -1,13 +1,48 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "TsAsset.h"
 #include "TsDeviceManager.h"
 #include "TsBlueprintFunctionLibrary.generated.h"
 
+/*!
+    \brief Result of playing haptic asset on multiple devices.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsHapticBroadcastResult
+{
+    GENERATED_BODY()
+
+    /*! Number of devices which started playing. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    int32 DeviceCount = 0;
+
+    /*! Time between the first and the last device start in milliseconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|Haptic")
+    float SkewMs = 0.0f;
+};
+
 UCLASS()
 class TESLASUIT_API UTsBlueprintFunctionLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 public:
-	
+    /*!
+        \brief Plays haptic asset on all listed devices at once.
+
+        Disconnected devices are skipped. Play commands are dispatched to devices in parallel,
+        see #TsHapticAssetManager::PlayOnDevices.
+
+        \return FTsHapticBroadcastResult
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
+    static FTsHapticBroadcastResult PlayHapticOnDevices(const TArray<UTsDevice*>& Devices, UTsAsset* Asset);
+
+    /*!
+        \brief Plays haptic asset on all devices connected to the device manager.
+
+        \return FTsHapticBroadcastResult
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Haptic")
+    static FTsHapticBroadcastResult PlayHapticOnAllDevices(UTsDeviceManager* DeviceManager, UTsAsset* Asset);
 };
@@ -1,11 +1,17 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #pragma once
-#include <mutex>
+#include <map>
+#include <memory>
 #include "CoreMinimal.h"
 #include "TsDevice.h"
+#include "Tickable.h"
+#include "TsStreamHealth.h"
+#include "Motion/TsMocapFrameBus.h"
 #include "TsMocap.generated.h"
 
+class UTsMocapFilterSettings;
+
 /**
  * \defgroup mocap Mocap Module
  * 
@@ -76,9 +82,20 @@ enum class FTsBoneIndex: uint8
 
 /*!
      \brief Controls mocap streaming from provided #UTsDevice.
+
+     Device callback only copies raw bones into a ring, conversion runs on a plugin owned
+     stream worker of the device. Converted poses are published to #TsMocapFrameBus,
+     consumers such as animation, recording or networking read them with their own #TsMocapFrameBus::Reader.
+     Stream rate, jitter and lost frames are tracked by a lock-free monitor, see #GetStreamHealth.
+
+     All mocap objects set to the same device share a single stream, device callbacks are registered
+     once and the per-device cost doesn't depend on the number of mocap objects, e.g. for mirrors or
+     lobby avatars of one suit. Stream settings such as filter and rotation offsets are shared too,
+     the latest applied ones are in effect. Streaming stops when the last mocap object of the device
+     is stopped or destroyed.
  */
 UCLASS(Blueprintable, ClassGroup = Teslasuit, Category = "Teslasuit|Mocap")
-class TESLASUIT_API UTsMocap : public UObject
+class TESLASUIT_API UTsMocap : public UObject, public FTickableGameObject
 {
 	GENERATED_BODY()
 public:
@@ -94,12 +111,12 @@ public:
     void Initialize();
 
     /*!
-        \brief Starts mocap streaming.
+        \brief Joins mocap stream of the device, streaming starts with its first mocap object.
     */
 	void StartMocap();
 
     /*!
-        \brief Stops mocap streaming.
+        \brief Leaves mocap stream of the device, streaming stops with its last mocap object.
     */
 	void StopMocap();
 
@@ -110,16 +127,81 @@ public:
 	void Calibrate();
 
     /*!
-        \brief Copies mocap data to provided buffer.
+        \brief Sets rotation offset of the bone, applied in bone local space during conversion.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+    void SetBoneRotationOffset(FTsBoneIndex Bone, FRotator Offset);
+
+    /*!
+        \brief Removes rotation offsets of all bones.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+    void ClearBoneRotationOffsets();
+
+    /*!
+        \brief Declares bones the consumer reads, as bitmask of #FTsBoneIndex.
+
+        Device callback extracts and converts only bones required by any consumer,
+        zero mask removes the consumer. Without consumers all bones are streamed.
+    */
+    void SetRequiredBones(const void* Consumer, std::uint64_t Mask);
+
+    /*!
+        \brief Sets smoothing of mocap poses, nullptr disables smoothing.
+
+        Filter runs on the stream worker at the sensor rate.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Mocap")
+    void SetFilterSettings(UTsMocapFilterSettings* Settings);
+
+    /*!
+        \brief Copies latest mocap data to provided buffer.
+
+        All bones are streamed while mocap data is read, reading stops a second after the last call.
     */
     void GetMocapData(MocapData& OutData) const;
 
+    /*!
+        \brief Creates reader of converted mocap frames.
+
+        Any number of readers can be created, readers don't add work to mocap streaming.
+    */
+    std::unique_ptr<TsMocapFrameBus::Reader> CreateFrameReader() const;
+
+    /*!
+        \brief Frame bus readers are created for, changes when mocap is set to another device.
+    */
+    const TsMocapFrameBus* GetFrameBus() const;
+
     /*!
         \brief Sets #UTsDevice to stream data from.
     */
 	UFUNCTION(BlueprintCallable, Category = "Teslasuit|General")
 	void SetTsDevice(UTsDevice* device);
 	
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /*!
+        \brief Returns stream health over the last second.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Mocap")
+    FTsStreamHealth GetStreamHealth() const;
+
+    /*!
+        \brief Limits of healthy stream for OnStreamHealthChanged.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Mocap")
+    FTsStreamHealthThresholds HealthThresholds;
+
+    /*!
+        \brief Called when stream becomes unhealthy or recovers.
+    */
+    UPROPERTY(BlueprintAssignable, Category = "Teslasuit|Mocap")
+    FTsStreamHealthDelegate OnStreamHealthChanged;
+
     /*!
         \brief Is mocap subsystem initialized with device.
     */
@@ -127,14 +209,28 @@ public:
     bool DeviceInitialized = false;
 
 private:
-	void SetCallbacks();
+    friend struct TsMocapStreamBenchmark;
+    struct StreamState;
+
+    static std::shared_ptr<StreamState> AcquireStream(UTsDevice* Device);
+    void Attach(std::shared_ptr<StreamState> NewStream);
+    void ApplyRotationOffsets();
 
 private:
 	UTsDevice* ts_device {nullptr};
     bool bMocapRunning = false;
-    mutable std::mutex AccessMutex;
+    bool bStreamHealthy = true;
+
+    UPROPERTY()
+    UTsMocapFilterSettings* FilterSettings = nullptr;
+    bool bFilterSettingsSet = false;
+    TMap<FTsBoneIndex, FRotator> RotationOffsets;
 
-    MocapData Data;
+    std::shared_ptr<StreamState> Stream;
+    std::map<const void*, std::uint64_t> RequiredBones;
+    mutable std::unique_ptr<TsMocapFrameBus::Reader> DataReader;
+    mutable double LastDataReadTime = 0.0;
+    mutable MocapData Data;
 };
 
 /**@}*/
@@ -1,9 +1,11 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #pragma once
-#include <mutex>
+#include <memory>
 #include "CoreMinimal.h"
+#include "Tickable.h"
 #include "TsDevice.h"
+#include "TsStreamHealth.h"
 #include "TsPpg.generated.h"
 
 /**
@@ -15,9 +17,11 @@
 
 /*!
     \brief Controls PPG streaming from provided #UTsDevice.
+
+    Device callback only copies readings into a ring, they are published on a plugin owned stream worker.
 */
 UCLASS(Blueprintable, ClassGroup = Teslasuit, Category = "Teslasuit|Biometry")
-class TESLASUIT_API UTsPpg : public UObject
+class TESLASUIT_API UTsPpg : public UObject, public FTickableGameObject
 {
 	GENERATED_BODY()
 public:
@@ -51,6 +55,29 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Teslasuit|Biometry")
     void Calibrate();
 
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    /*!
+        \brief Returns stream health over the last second.
+    */
+    UFUNCTION(BlueprintPure, Category = "Teslasuit|Biometry")
+    FTsStreamHealth GetStreamHealth() const;
+
+    /*!
+        \brief Limits of healthy stream for OnStreamHealthChanged.
+    */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|Biometry")
+    FTsStreamHealthThresholds HealthThresholds;
+
+    /*!
+        \brief Called when stream becomes unhealthy or recovers.
+    */
+    UPROPERTY(BlueprintAssignable, Category = "Teslasuit|Biometry")
+    FTsStreamHealthDelegate OnStreamHealthChanged;
+
     /*!
         \brief Is PPG subsystem initialized with device.
     */
@@ -73,9 +100,11 @@ private:
 	void SetCallbacks();
 
 private:
+    struct StreamState;
+
 	UTsDevice* ts_device {nullptr};
     bool bPpgRunning = false;
-    mutable std::mutex AccessMutex;
+    std::shared_ptr<StreamState> Stream;
 };
 
 /**@}*/
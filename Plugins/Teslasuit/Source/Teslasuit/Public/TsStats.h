@@ -0,0 +1,17 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/**
+ * \addtogroup core
+ * @{
+ */
+
+/*!
+    \brief Stat group of Teslasuit plugin.
+
+    Plugin counters can be displayed in game with "stat Teslasuit" console command.
+*/
+DECLARE_STATS_GROUP(TEXT("Teslasuit"), STATGROUP_Teslasuit, STATCAT_Advanced);
+
+/**@}*/
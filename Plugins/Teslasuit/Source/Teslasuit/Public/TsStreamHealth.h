@@ -0,0 +1,76 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TsStreamHealth.generated.h"
+
+/**
+ * \addtogroup core
+ * @{
+ */
+
+/*!
+    \brief Health of a device data stream over the last measurement window.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsStreamHealth
+{
+    GENERATED_BODY()
+
+    /*! Samples received per second. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    float RateHz = 0.0f;
+
+    /*! Median deviation of sample interval from its average, in milliseconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    float JitterP50Ms = 0.0f;
+
+    /*! 90th percentile of sample interval deviation, in milliseconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    float JitterP90Ms = 0.0f;
+
+    /*! 99th percentile of sample interval deviation, in milliseconds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    float JitterP99Ms = 0.0f;
+
+    /*! Discontinuities in the stream during the window. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    int32 Gaps = 0;
+
+    /*! Estimated samples lost in gaps during the window. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    int32 MissedSamples = 0;
+
+    /*! Samples received but dropped because processing was behind, during the window. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    int32 DroppedSamples = 0;
+
+    /*! Stream satisfies configured thresholds. */
+    UPROPERTY(BlueprintReadOnly, Category = "Teslasuit|General")
+    bool bHealthy = true;
+};
+
+/*!
+    \brief Limits of a healthy stream, negative value disables a limit.
+
+    All limits are disabled by default, owners of the stream set the ones which fit its rate.
+*/
+USTRUCT(BlueprintType)
+struct TESLASUIT_API FTsStreamHealthThresholds
+{
+    GENERATED_BODY()
+
+    /*! Minimal samples rate. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|General", meta = (ClampMin = "-1.0"))
+    float MinRateHz = -1.0f;
+
+    /*! Maximal 99th percentile of jitter, in milliseconds. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|General", meta = (ClampMin = "-1.0"))
+    float MaxJitterMs = -1.0f;
+
+    /*! Maximal missed and dropped samples per window, zero tolerates no lost samples. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Teslasuit|General", meta = (ClampMin = "-1"))
+    int32 MaxLostSamples = -1;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTsStreamHealthDelegate, const FTsStreamHealth&, Health);
+
+/**@}*/
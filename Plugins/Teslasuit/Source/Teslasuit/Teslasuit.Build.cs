@@ -29,7 +29,9 @@ public class Teslasuit : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core"
+				"Core",
+				"MovieScene",
+				"AudioMixerCore"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -47,6 +49,9 @@ public class Teslasuit : ModuleRules
 				"Slate",
 				"SlateCore",
 				"ProceduralMeshComponent",
+				"AudioMixer",
+				"RenderCore",
+				"AssetRegistry",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
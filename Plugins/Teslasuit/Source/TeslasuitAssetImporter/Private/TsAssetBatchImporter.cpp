@@ -0,0 +1,133 @@
+#include "TsAssetBatchImporter.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "ObjectTools.h"
+#include "UObject/Package.h"
+#include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+
+namespace
+{
+    struct FTsImportFile
+    {
+        FString Path;
+        TArray<uint8> Bytes;
+        FString Hash;
+        ETsAssetType Type = ETsAssetType::Undefined;
+        float Duration = 0.0f;
+    };
+
+    TMap<FString, FAssetData> FindImportedAssets()
+    {
+        // Content hash is an asset registry tag, so assets are not loaded to find duplicates
+        TMap<FString, FAssetData> Assets;
+        auto& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        TArray<FAssetData> AssetDatas;
+        AssetRegistry.GetAssetsByClass(UTsAsset::StaticClass()->GetClassPathName(), AssetDatas);
+        for (const auto& AssetData : AssetDatas)
+        {
+            FString Hash;
+            if (AssetData.GetTagValue(TEXT("ContentHash"), Hash) && !Hash.IsEmpty() && !Assets.Contains(Hash))
+            {
+                Assets.Add(Hash, AssetData);
+            }
+        }
+        return Assets;
+    }
+
+    FString MakeUniquePackageName(const FString& DestinationPath, const FString& Name)
+    {
+        FString PackageName = DestinationPath / Name;
+        for (int32 Suffix = 1; FPackageName::DoesPackageExist(PackageName) || FindPackage(nullptr, *PackageName) != nullptr; ++Suffix)
+        {
+            PackageName = DestinationPath / FString::Printf(TEXT("%s_%i"), *Name, Suffix);
+        }
+        return PackageName;
+    }
+}
+
+TArray<UTsAsset*> UTsAssetBatchImporter::ImportFiles(const TArray<FString>& Files, const FString& DestinationPath)
+{
+    TArray<UTsAsset*> Result;
+    if (!FPackageName::IsValidLongPackageName(DestinationPath / TEXT("Asset")))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UTsAssetBatchImporter: failed to import - invalid destination path %s."), *DestinationPath);
+        return Result;
+    }
+
+    // Read and hash files in parallel
+    TArray<FTsImportFile> Imports;
+    Imports.SetNum(Files.Num());
+    ParallelFor(Files.Num(), [&Files, &Imports](int32 Index)
+    {
+        auto& Import = Imports[Index];
+        Import.Path = Files[Index];
+        if (!FFileHelper::LoadFileToArray(Import.Bytes, *Import.Path))
+        {
+            return;
+        }
+        FSHAHash Hash;
+        FSHA1::HashBuffer(Import.Bytes.GetData(), Import.Bytes.Num(), Hash.Hash);
+        Import.Hash = Hash.ToString();
+    });
+
+    // C API isn't guaranteed to be reentrant, so files are validated one by one
+    auto& AM = ITeslasuitPlugin::Get().GetHapticAssetManager();
+    for (auto& Import : Imports)
+    {
+        if (Import.Bytes.Num() > 0)
+        {
+            Import.Type = AM.InspectAsset(Import.Bytes.GetData(), Import.Bytes.Num(), &Import.Duration);
+        }
+    }
+
+    // Create objects on game thread, duplicates reuse existing assets
+    const auto Registered = FindImportedAssets();
+    TMap<FString, UTsAsset*> Imported;
+    for (auto& Import : Imports)
+    {
+        if (Import.Type == ETsAssetType::Undefined)
+        {
+            UE_LOG(LogTemp, Error, TEXT("UTsAssetBatchImporter: failed to import %s - invalid Teslasuit asset."), *Import.Path);
+            continue;
+        }
+        auto Existing = Imported.FindRef(Import.Hash);
+        if (Existing == nullptr && Registered.Contains(Import.Hash))
+        {
+            Existing = Cast<UTsAsset>(Registered[Import.Hash].GetAsset());
+        }
+        if (Existing != nullptr)
+        {
+            UE_LOG(LogTemp, Log, TEXT("UTsAssetBatchImporter: %s is a duplicate of %s."), *Import.Path, *Existing->GetPathName());
+            Imported.Add(Import.Hash, Existing);
+            Result.Add(Existing);
+            continue;
+        }
+
+        const FString PackageName = MakeUniquePackageName(DestinationPath, ObjectTools::SanitizeObjectName(FPaths::GetBaseFilename(Import.Path)));
+        auto Package = CreatePackage(*PackageName);
+        auto Asset = NewObject<UTsAsset>(Package, UTsAsset::StaticClass(), *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone | RF_Transactional);
+        Asset->Initialize(Import.Bytes.GetData(), Import.Bytes.Num());
+        Asset->SetAssetType(Import.Type);
+        Asset->SetDuration(Import.Duration);
+        FAssetRegistryModule::AssetCreated(Asset);
+        Package->MarkPackageDirty();
+
+        Imported.Add(Import.Hash, Asset);
+        Result.Add(Asset);
+    }
+    UE_LOG(LogTemp, Log, TEXT("UTsAssetBatchImporter: imported %i of %i files."), Result.Num(), Files.Num());
+    return Result;
+}
+
+TArray<UTsAsset*> UTsAssetBatchImporter::ImportDirectory(const FString& Directory, const FString& DestinationPath)
+{
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive(Files, *Directory, TEXT("*.ts_asset"), true, false);
+    return ImportFiles(Files, DestinationPath);
+}
@@ -1,5 +1,8 @@
 #include "TsAssetFactory.h"
 #include "TsAsset.h"
+#include "ITeslasuitPlugin.h"
+#include "Haptic/TsHapticAssetManager.h"
+#include "Misc/FeedbackContext.h"
 
 UTsAssetFactory::UTsAssetFactory()
 {
@@ -15,7 +18,19 @@ UObject* UTsAssetFactory::FactoryCreateBinary(UClass* InClass, UObject* InParent
     FFeedbackContext* Warn, bool& bOutOperationCanceled)
 {
     const std::size_t Size = BufferEnd - Buffer;
+
+    // Parse asset once on import, invalid files are not imported
+    float Duration = 0.0f;
+    const auto Type = ITeslasuitPlugin::Get().GetHapticAssetManager().InspectAsset(Buffer, Size, &Duration);
+    if (Type == ETsAssetType::Undefined)
+    {
+        Warn->Logf(ELogVerbosity::Error, TEXT("UTsAssetFactory: failed to import %s - invalid Teslasuit asset."), *InName.ToString());
+        return nullptr;
+    }
+
     auto Asset = NewObject<UTsAsset>(InParent, UTsAsset::StaticClass(), InName, Flags);
     Asset->Initialize(Buffer, Size);
+    Asset->SetAssetType(Type);
+    Asset->SetDuration(Duration);
     return Asset;
 }
@@ -0,0 +1,43 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "TsAsset.h"
+#include "TsAssetBatchImporter.generated.h"
+
+/**
+ * \addtogroup asset
+ * @{
+ */
+
+/*!
+   \brief Imports many ".ts_asset" files at once.
+
+   Files are read, hashed and validated in parallel, #UTsAsset objects are created afterwards
+   on game thread. Files which content equals already imported asset or another file of the batch
+   are not imported again, existing asset is returned for them instead.
+ */
+UCLASS()
+class TESLASUITASSETIMPORTER_API UTsAssetBatchImporter : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+public:
+    /*!
+        \brief Imports files into content folder, e.g. "/Game/Haptics".
+
+        Returns asset for each imported file, invalid files are skipped.
+
+        \return TArray<UTsAsset*>
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Asset")
+    static TArray<UTsAsset*> ImportFiles(const TArray<FString>& Files, const FString& DestinationPath);
+
+    /*!
+        \brief Imports all ".ts_asset" files of a directory and its subdirectories.
+
+        \return TArray<UTsAsset*>
+    */
+    UFUNCTION(BlueprintCallable, Category = "Teslasuit|Asset")
+    static TArray<UTsAsset*> ImportDirectory(const FString& Directory, const FString& DestinationPath);
+};
+
+/**@}*/
@@ -37,6 +37,7 @@ public class TeslasuitAssetImporter : ModuleRules
             "Slate",
             "SlateCore",
             "UnrealEd",
+            "AssetRegistry",
             "Teslasuit"	
             // ... add private dependencies that you statically link with here ...  
             }
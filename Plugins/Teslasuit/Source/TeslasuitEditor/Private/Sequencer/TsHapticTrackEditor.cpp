@@ -0,0 +1,108 @@
+#include "Sequencer/TsHapticTrackEditor.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "GameFramework/Actor.h"
+#include "ISequencerSection.h"
+#include "MovieScene.h"
+#include "Haptic/TsHapticPlayer.h"
+#include "Sequencer/MovieSceneTsHapticSection.h"
+#include "Sequencer/MovieSceneTsHapticTrack.h"
+
+#define LOCTEXT_NAMESPACE "TeslasuitEditor"
+
+namespace
+{
+    class FTsHapticSection : public FSequencerSection
+    {
+    public:
+        FTsHapticSection(UMovieSceneSection& InSection)
+            : FSequencerSection(InSection)
+        {
+        }
+
+        virtual FText GetSectionTitle() const override
+        {
+            auto Section = Cast<UMovieSceneTsHapticSection>(WeakSection.Get());
+            if (Section == nullptr || Section->Asset == nullptr)
+            {
+                return LOCTEXT("TsHapticNoAsset", "No Haptic Asset");
+            }
+            return FText::FromString(Section->Asset->GetName());
+        }
+    };
+}
+
+FTsHapticTrackEditor::FTsHapticTrackEditor(TSharedRef<ISequencer> InSequencer)
+    : FMovieSceneTrackEditor(InSequencer)
+{
+}
+
+TSharedRef<ISequencerTrackEditor> FTsHapticTrackEditor::CreateTrackEditor(TSharedRef<ISequencer> OwningSequencer)
+{
+    return MakeShareable(new FTsHapticTrackEditor(OwningSequencer));
+}
+
+bool FTsHapticTrackEditor::SupportsType(TSubclassOf<UMovieSceneTrack> Type) const
+{
+    return Type == UMovieSceneTsHapticTrack::StaticClass();
+}
+
+TSharedRef<ISequencerSection> FTsHapticTrackEditor::MakeSectionInterface(UMovieSceneSection& SectionObject, UMovieSceneTrack& Track, FGuid ObjectBinding)
+{
+    return MakeShareable(new FTsHapticSection(SectionObject));
+}
+
+void FTsHapticTrackEditor::BuildObjectBindingTrackMenu(FMenuBuilder& MenuBuilder, const TArray<FGuid>& ObjectBindings, const UClass* ObjectClass)
+{
+    if (ObjectClass == nullptr || !(ObjectClass->IsChildOf(AActor::StaticClass()) || ObjectClass->IsChildOf(UTsHapticPlayer::StaticClass())))
+    {
+        return;
+    }
+    MenuBuilder.AddMenuEntry(
+        LOCTEXT("AddTsHapticTrack", "Teslasuit Haptic"),
+        LOCTEXT("AddTsHapticTrackTooltip", "Adds a track playing haptic assets on the Teslasuit haptic player of the object."),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateRaw(this, &FTsHapticTrackEditor::AddTrack, ObjectBindings)));
+}
+
+bool FTsHapticTrackEditor::HandleAssetAdded(UObject* Asset, const FGuid& TargetObjectGuid)
+{
+    auto HapticAsset = Cast<UTsAsset>(Asset);
+    if (HapticAsset == nullptr || !TargetObjectGuid.IsValid())
+    {
+        return false;
+    }
+    AnimatablePropertyChanged(FOnKeyProperty::CreateRaw(this, &FTsHapticTrackEditor::AddSection, TargetObjectGuid, HapticAsset));
+    return true;
+}
+
+void FTsHapticTrackEditor::AddTrack(TArray<FGuid> ObjectBindings)
+{
+    for (const auto& ObjectBinding : ObjectBindings)
+    {
+        AnimatablePropertyChanged(FOnKeyProperty::CreateRaw(this, &FTsHapticTrackEditor::AddSection, ObjectBinding, static_cast<UTsAsset*>(nullptr)));
+    }
+}
+
+FKeyPropertyResult FTsHapticTrackEditor::AddSection(FFrameNumber KeyTime, FGuid ObjectBinding, UTsAsset* Asset)
+{
+    FKeyPropertyResult Result;
+    auto TrackResult = FindOrCreateTrackForObject(ObjectBinding, UMovieSceneTsHapticTrack::StaticClass());
+    auto Track = Cast<UMovieSceneTsHapticTrack>(TrackResult.Track);
+    Result.bTrackCreated = TrackResult.bWasCreated;
+    if (Track == nullptr)
+    {
+        return Result;
+    }
+
+    Track->Modify();
+    auto Section = CastChecked<UMovieSceneTsHapticSection>(Track->CreateNewSection());
+    Section->Asset = Asset;
+    const FFrameRate TickResolution = Track->GetTypedOuter<UMovieScene>()->GetTickResolution();
+    const int32 Duration = (DefaultSectionSeconds * TickResolution).FloorToFrame().Value;
+    Section->InitialPlacementOnRow(Track->GetAllSections(), KeyTime, Duration, INDEX_NONE);
+    Track->AddSection(*Section);
+    Result.bTrackModified = true;
+    return Result;
+}
+
+#undef LOCTEXT_NAMESPACE
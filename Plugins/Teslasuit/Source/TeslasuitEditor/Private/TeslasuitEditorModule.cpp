@@ -1,5 +1,7 @@
 // Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
 #include "ITeslasuitEditor.h"
+#include "ISequencerModule.h"
+#include "Sequencer/TsHapticTrackEditor.h"
 
 /**
 * SpeedTreeImporter module implementation (private)
@@ -9,13 +11,23 @@ class FTeslasuitEditorModule : public ITeslasuitEditor
 public:
     virtual void StartupModule() override
     {
+        auto& SequencerModule = FModuleManager::LoadModuleChecked<ISequencerModule>("Sequencer");
+        HapticTrackEditorHandle = SequencerModule.RegisterTrackEditor(FOnCreateTrackEditor::CreateStatic(&FTsHapticTrackEditor::CreateTrackEditor));
     }
 
 
     virtual void ShutdownModule() override
     {
+        auto SequencerModule = FModuleManager::GetModulePtr<ISequencerModule>("Sequencer");
+        if (SequencerModule != nullptr)
+        {
+            SequencerModule->UnRegisterTrackEditor(HapticTrackEditorHandle);
+        }
     }
 
+private:
+    FDelegateHandle HapticTrackEditorHandle;
+
 };
 
 IMPLEMENT_MODULE(FTeslasuitEditorModule, TeslasuitEditor);
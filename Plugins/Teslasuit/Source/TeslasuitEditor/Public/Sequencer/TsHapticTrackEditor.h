@@ -0,0 +1,35 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MovieSceneTrackEditor.h"
+
+class UTsAsset;
+
+/*!
+    \brief Sequencer editor of #UMovieSceneTsHapticTrack.
+
+    Adds "Teslasuit Haptic" track to actor bindings and creates sections
+    when haptic assets are dropped on a binding.
+*/
+class TESLASUITEDITOR_API FTsHapticTrackEditor : public FMovieSceneTrackEditor
+{
+public:
+    FTsHapticTrackEditor(TSharedRef<ISequencer> InSequencer);
+
+    static TSharedRef<ISequencerTrackEditor> CreateTrackEditor(TSharedRef<ISequencer> OwningSequencer);
+
+    // ISequencerTrackEditor interface
+    virtual bool SupportsType(TSubclassOf<UMovieSceneTrack> Type) const override;
+    virtual TSharedRef<ISequencerSection> MakeSectionInterface(UMovieSceneSection& SectionObject, UMovieSceneTrack& Track, FGuid ObjectBinding) override;
+    virtual void BuildObjectBindingTrackMenu(FMenuBuilder& MenuBuilder, const TArray<FGuid>& ObjectBindings, const UClass* ObjectClass) override;
+    virtual bool HandleAssetAdded(UObject* Asset, const FGuid& TargetObjectGuid) override;
+
+private:
+    void AddTrack(TArray<FGuid> ObjectBindings);
+    FKeyPropertyResult AddSection(FFrameNumber KeyTime, FGuid ObjectBinding, UTsAsset* Asset);
+
+private:
+    /*!
+        \brief Length of created sections, asset duration is known only to a device.
+    */
+    static constexpr float DefaultSectionSeconds = 1.0f;
+};
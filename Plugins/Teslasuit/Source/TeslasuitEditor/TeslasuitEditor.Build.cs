@@ -36,6 +36,7 @@ public class TeslasuitEditor : ModuleRules
             "Slate",
             "SlateCore",			
 			"Teslasuit", "AnimGraph", "BlueprintGraph",
+			"MovieScene", "MovieSceneTools", "Sequencer", "UnrealEd",
 			
         // ... add private dependencies that you statically link with here ...  
       }